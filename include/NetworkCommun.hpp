@@ -100,6 +100,9 @@ enum ConnectedOpcodes : std::uint8_t
   SENDCOMP = 0x02,
   SENDHEARTHBEAT = 0x03,
   FFGONEXT = 0x04,
+  EVENTTABLE = 0x05,
+  SENDEVENTID = 0x06,
+  EVENTTABLEACK = 0x07,
 };
 
 enum class ConnectionState : std::uint8_t
@@ -131,4 +134,6 @@ struct ClientInfo
   std::size_t last_reset;
   std::uint8_t reset_count;
   ByteArray frag_buffer;
+  bool event_table_acked = false;  ///< Events can be sent by id
+  std::size_t event_table_sent = 0;  ///< Last EVENTTABLE, for the resends
 };
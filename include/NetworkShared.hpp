@@ -1,12 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstddef>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <ostream>
 #include <queue>
 #include <semaphore>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -123,6 +129,12 @@ struct EventBuilder
 {
   std::string event_id;
   ByteArray data;
+  /**
+   * EventTypeId of the event in the local EventManager, set instead of
+   * event_id by the network layer when the sender used the id table
+   * exchanged on connection. Not serialized.
+   */
+  std::optional<std::size_t> local_id;
 
   EventBuilder() = default;
 
@@ -132,6 +144,12 @@ struct EventBuilder
   {
   }
 
+  EventBuilder(std::size_t id, ByteArray d)
+      : data(std::move(d))
+      , local_id(id)
+  {
+  }
+
   DEFAULT_BYTE_CONSTRUCTOR(EventBuilder,
                            ([](std::string const& i, ByteArray const& d)
                             { return EventBuilder(i, d); }),
@@ -429,6 +447,154 @@ struct SharedQueue
   std::queue<T> queue;
 };
 
+/**
+ * @brief Bounded lock-free queue, many producer threads and one consumer
+ *
+ * Carries the network receive threads' data to the frame loop. Each cell
+ * holds a sequence number telling whether it is free or filled for a given
+ * position: producers claim a position with one compare-exchange and
+ * publish the cell with a release store, the consumer reads cells in
+ * place. No lock, no allocation after construction.
+ *
+ * When the consumer falls a whole ring behind, try_push() fails instead of
+ * blocking the receive thread, push() waits for a free cell instead.
+ *
+ * @code
+ * MpscRing<EventBuilder> ring(1024);
+ *
+ * ring.try_push(EventBuilder(...));  // any thread
+ * ring.drain([](EventBuilder& evt) { ... });  // frame loop only
+ * @endcode
+ */
+template<typename T>
+class MpscRing
+{
+public:
+  /**
+   * @param capacity Rounded up to a power of two
+   */
+  explicit MpscRing(std::size_t capacity = 4096)
+      : _mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+      , _cells(std::make_unique<Cell[]>(this->_mask + 1))
+  {
+    for (std::size_t i = 0; i <= this->_mask; i++) {
+      this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(MpscRing const&) = delete;
+  MpscRing& operator=(MpscRing const&) = delete;
+
+  /**
+   * @brief Appends a value, from any thread
+   *
+   * @return false if the ring is full, value is then left untouched
+   */
+  bool try_push(T&& value)
+  {
+    std::size_t pos = this->_tail.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    while (true) {
+      cell = &this->_cells[pos & this->_mask];
+      std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+      if (seq == pos) {
+        if (this->_tail.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (seq < pos) {
+        return false;  // Still holds the value of the previous lap
+      } else {
+        pos = this->_tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(T const& value) { return this->try_push(T(value)); }
+
+  /**
+   * @brief Appends a value, waiting for the consumer while the ring is full
+   *
+   * Spins a few attempts, then yields between them. The producer must not
+   * hold anything the consumer waits on.
+   *
+   * @param running Cleared on shutdown, stops the wait
+   * @return false if running was cleared first, value is then left untouched
+   */
+  bool push(T&& value, std::atomic<bool> const& running)
+  {
+    for (std::size_t attempt = 0; !this->try_push(std::move(value)); attempt++)
+    {
+      if (!running.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      if (attempt >= spin_attempts) {
+        std::this_thread::yield();
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Hands every published value to f, in push order
+   *
+   * Only one thread may drain. f receives the value in its cell and may
+   * move from it. Stops after one ring's worth of values, so producers
+   * cannot keep the consumer looping.
+   *
+   * @return Number of values handed to f
+   */
+  template<typename Function>
+  std::size_t drain(Function&& f)
+  {
+    std::size_t count = 0;
+
+    while (count <= this->_mask) {
+      Cell& cell = this->_cells[this->_head & this->_mask];
+
+      if (cell.sequence.load(std::memory_order_acquire) != this->_head + 1) {
+        break;
+      }
+      f(cell.value);
+      cell.value = T();
+      cell.sequence.store(this->_head + this->_mask + 1,
+                          std::memory_order_release);
+      this->_head += 1;
+      count += 1;
+    }
+    return count;
+  }
+
+  std::size_t capacity() const { return this->_mask + 1; }
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence = 0;
+    T value;
+  };
+
+  static constexpr std::size_t spin_attempts = 64;
+
+  std::size_t _mask;
+  std::unique_ptr<Cell[]> _cells;
+  alignas(64) std::atomic<std::size_t> _tail = 0;  ///< Next producer position
+  alignas(64) std::size_t _head = 0;  ///< Next position to drain
+};
+
+/**
+ * @brief Priority of the systems draining the receive rings: they run first,
+ * so what arrived since the last frame is applied before the game systems
+ */
+static constexpr std::size_t NETWORK_DRAIN_PRIORITY =
+    std::numeric_limits<std::size_t>::max();
+
 template<typename K, typename V>
 struct SharedMap
 {
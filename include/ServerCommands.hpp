@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "ByteParser/ByteParser.hpp"
 #include "Parser.hpp"
@@ -118,3 +120,28 @@ inline Parser<ConnectedCommand> parse_connected_cmd()
                parseByte<std::uint8_t>(),
                parseByte<Byte>().many());
 }
+
+/**
+ * @brief Event sent by id, see EventManager::event_names()
+ */
+struct EventIdCommand
+{
+  std::uint32_t event_id;
+  ByteArray data;
+};
+
+inline Parser<EventIdCommand> parse_event_id_cmd()
+{
+  return apply([](std::uint32_t id, ByteArray d)
+               { return EventIdCommand(id, std::move(d)); },
+               parseByte<std::uint32_t>(),
+               parseByte<Byte>().many());
+}
+
+/**
+ * @brief Event names of the server, indexed by event id
+ */
+inline Parser<std::vector<std::string>> parse_event_table()
+{
+  return parseByteArray(parseByteString());
+}
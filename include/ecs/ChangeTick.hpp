@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Stamp of a component write, see Registry::change_tick()
+ *
+ * Ticks only grow. 0 means "before any write", a filter starting at 0
+ * accepts every component.
+ */
+using ChangeTick = std::uint64_t;
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Json/JsonParser.hpp"
+#include "ecs/Entity.hpp"
+#include "ecs/EventManager.hpp"
+#include "ecs/Registry.hpp"
+
+/**
+ * @class CommandBuffer
+ * @brief Structural changes and events recorded now, applied later in a batch
+ *
+ * Spawning, killing, adding or removing components and emitting events are
+ * not safe while a Zipper walks the storages nor from concurrent systems.
+ * Instead of queueing one std::function per entity, record the change here:
+ * each command is constructed in place in a linear arena of fixed blocks,
+ * recording allocates nothing once the blocks are warm and applying is a
+ * single pass over contiguous memory.
+ *
+ * Registry::commands() gives the buffer of the running code, applied by
+ * run_systems() after each batch of systems. A local buffer may also be
+ * applied by hand with apply().
+ *
+ * @code
+ * for (auto&& [e, health] : ZipperIndex<Health const>(r)) {
+ *   if (health.current <= 0) {
+ *     r.commands().emit<DeathEvent>(e);
+ *     r.commands().remove<Health>(e);
+ *   }
+ * }
+ * @endcode
+ *
+ * @note Commands are applied in recording order. Commands recorded while
+ * applying (by an event handler for instance) run in the same apply().
+ */
+class CommandBuffer
+{
+public:
+  CommandBuffer() = default;
+
+  ~CommandBuffer() { this->clear(); }
+
+  CommandBuffer(CommandBuffer const&) = delete;
+  CommandBuffer& operator=(CommandBuffer const&) = delete;
+
+  CommandBuffer(CommandBuffer&& other) noexcept
+      : _blocks(std::move(other._blocks))
+      , _current(std::exchange(other._current, 0))
+      , _size(std::exchange(other._size, 0))
+  {
+    other._blocks.clear();
+  }
+
+  CommandBuffer& operator=(CommandBuffer&& other) noexcept
+  {
+    if (this != &other) {
+      this->clear();
+      this->_blocks = std::move(other._blocks);
+      this->_current = std::exchange(other._current, 0);
+      this->_size = std::exchange(other._size, 0);
+      other._blocks.clear();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Spawns an entity owning the given components
+   */
+  template<class... Components>
+  void spawn(Components&&... components)
+  {
+    this->record<SpawnCommand<std::decay_t<Components>...>>(
+        std::forward<Components>(components)...);
+  }
+
+  /**
+   * @brief Marks an entity for deletion, see Registry::kill_entity()
+   */
+  void kill(Ecs::Entity e) { this->record<KillCommand>(e); }
+
+  /**
+   * @brief Adds or replaces a component of an entity
+   */
+  template<class Component>
+  void add(Ecs::Entity e, Component&& component)
+  {
+    this->record<AddCommand<std::decay_t<Component>>>(
+        e, std::forward<Component>(component));
+  }
+
+  /**
+   * @brief Removes a component from an entity
+   */
+  template<class Component>
+  void remove(Ecs::Entity e)
+  {
+    this->record<RemoveCommand<Component>>(e);
+  }
+
+  /**
+   * @brief Emits a typed event, constructed from args when applied
+   */
+  template<class EventType, class... Args>
+  void emit(Args&&... args)
+  {
+    this->record<EmitCommand<EventType, std::decay_t<Args>...>>(
+        std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Emits an event by name, see EventManager::emit(Registry&, ...)
+   */
+  void emit(std::string name,
+            JsonObject params,
+            std::optional<Ecs::Entity> entity = std::nullopt)
+  {
+    this->record<NamedEmitCommand>(
+        std::move(name), std::move(params), entity);
+  }
+
+  /**
+   * @brief Calls fn(Registry&, EventManager&) when applied
+   *
+   * The callable is stored in the arena, for work that is not a single
+   * structural change or event.
+   */
+  template<class Function>
+  void call(Function&& fn)
+  {
+    this->record<CallCommand<std::decay_t<Function>>>(
+        std::forward<Function>(fn));
+  }
+
+  /**
+   * @brief Applies then discards every recorded command, in order
+   */
+  void apply(Registry& r, EventManager& em)
+  {
+    // Indices, not iterators: applied commands may record new ones
+    for (std::size_t b = 0; b < this->_blocks.size(); b++) {
+      for (std::size_t at = 0; at < this->_blocks[b].used;) {
+        auto* header =
+            reinterpret_cast<Header*>(this->_blocks[b].data.get() + at);
+
+        at += header->size;
+        if (header->apply == nullptr) {
+          continue;
+        }
+        void* payload = reinterpret_cast<std::byte*>(header) + header_size;
+        auto apply = std::exchange(header->apply, nullptr);
+        auto destroy = std::exchange(header->destroy, nullptr);
+
+        try {
+          apply(payload, r, em);
+        } catch (...) {
+          destroy(payload);
+          throw;
+        }
+        destroy(payload);
+      }
+    }
+    this->reset();
+  }
+
+  /**
+   * @brief Moves the commands of another buffer after the ones of this one
+   *
+   * The blocks are handed over, no command is copied. Empty blocks are kept
+   * for the next records.
+   */
+  void append(CommandBuffer&& other)
+  {
+    std::size_t last = this->_blocks.size() + other._current;
+
+    for (auto& block : other._blocks) {
+      this->_blocks.push_back(std::move(block));
+    }
+    if (other._size != 0) {
+      this->_current = last;
+    }
+    this->_size += std::exchange(other._size, 0);
+    other._blocks.clear();
+    other._current = 0;
+  }
+
+  /**
+   * @brief Hands up to count unused blocks over to another buffer
+   *
+   * A short-lived buffer given blocks kept from earlier rounds records
+   * without allocating, append() brings the blocks back.
+   */
+  void lend_blocks(CommandBuffer& to, std::size_t count)
+  {
+    while (count > 0 && this->_blocks.size() > this->_current + 1
+           && this->_blocks.back().used == 0)
+    {
+      to._blocks.push_back(std::move(this->_blocks.back()));
+      this->_blocks.pop_back();
+      count -= 1;
+    }
+  }
+
+  /**
+   * @brief Discards every recorded command without applying it
+   */
+  void clear()
+  {
+    for (auto& block : this->_blocks) {
+      for (std::size_t at = 0; at < block.used;) {
+        auto* header = reinterpret_cast<Header*>(block.data.get() + at);
+
+        at += header->size;
+        if (header->destroy != nullptr) {
+          header->destroy(reinterpret_cast<std::byte*>(header) + header_size);
+        }
+      }
+    }
+    this->reset();
+  }
+
+  bool empty() const { return this->_size == 0; }
+
+  /**
+   * @brief Number of commands recorded since the last apply() or clear()
+   */
+  std::size_t size() const { return this->_size; }
+
+  /**
+   * @brief Arena blocks owned by the buffer, in use or kept for later
+   */
+  std::size_t block_count() const { return this->_blocks.size(); }
+
+private:
+  struct KillCommand
+  {
+    Ecs::Entity entity;
+
+    void operator()(Registry& r, EventManager&) { r.kill_entity(entity); }
+  };
+
+  template<class Component>
+  struct AddCommand
+  {
+    template<class Arg>
+    AddCommand(Ecs::Entity e, Arg&& arg)
+        : entity(e)
+        , component(std::forward<Arg>(arg))
+    {
+    }
+
+    void operator()(Registry& r, EventManager&)
+    {
+      r.add_component(entity, std::move(component));
+    }
+
+    Ecs::Entity entity;
+    Component component;
+  };
+
+  template<class Component>
+  struct RemoveCommand
+  {
+    Ecs::Entity entity;
+
+    void operator()(Registry& r, EventManager&)
+    {
+      r.remove_component<Component>(entity);
+    }
+  };
+
+  template<class... Components>
+  struct SpawnCommand
+  {
+    template<class... Args>
+    explicit SpawnCommand(Args&&... args)
+        : components(std::forward<Args>(args)...)
+    {
+    }
+
+    void operator()(Registry& r, EventManager&)
+    {
+      Ecs::Entity e = r.spawn_entity();
+
+      std::apply([&r, e](Components&... c)
+                 { (r.add_component(e, std::move(c)), ...); },
+                 components);
+    }
+
+    std::tuple<Components...> components;
+  };
+
+  template<class EventType, class... Args>
+  struct EmitCommand
+  {
+    template<class... Params>
+    explicit EmitCommand(Params&&... params)
+        : args(std::forward<Params>(params)...)
+    {
+    }
+
+    void operator()(Registry&, EventManager& em)
+    {
+      std::apply([&em](Args&... a)
+                 { em.emit<EventType>(std::move(a)...); },
+                 args);
+    }
+
+    std::tuple<Args...> args;
+  };
+
+  struct NamedEmitCommand
+  {
+    NamedEmitCommand(std::string n,
+                     JsonObject p,
+                     std::optional<Ecs::Entity> e)
+        : name(std::move(n))
+        , params(std::move(p))
+        , entity(e)
+    {
+    }
+
+    void operator()(Registry& r, EventManager& em)
+    {
+      em.emit(r, name, params, entity);
+    }
+
+    std::string name;
+    JsonObject params;
+    std::optional<Ecs::Entity> entity;
+  };
+
+  template<class Function>
+  struct CallCommand
+  {
+    template<class Arg>
+    explicit CallCommand(Arg&& arg)
+        : fn(std::forward<Arg>(arg))
+    {
+    }
+
+    void operator()(Registry& r, EventManager& em) { fn(r, em); }
+
+    Function fn;
+  };
+
+  /**
+   * @brief Precedes each command in the arena
+   */
+  struct Header
+  {
+    void (*apply)(void*, Registry&, EventManager&);
+    void (*destroy)(void*);
+    std::size_t size;  ///< Header and payload, padded
+  };
+
+  struct Block
+  {
+    explicit Block(std::size_t cap)
+        : data(new std::byte[cap])
+        , capacity(cap)
+    {
+    }
+
+    std::unique_ptr<std::byte[]> data;
+    std::size_t capacity;
+    std::size_t used = 0;
+  };
+
+  static constexpr std::size_t align = alignof(std::max_align_t);
+  static constexpr std::size_t block_size = 4096;
+
+  static constexpr std::size_t padded(std::size_t size)
+  {
+    return (size + align - 1) / align * align;
+  }
+
+  static constexpr std::size_t header_size =
+      (sizeof(Header) + align - 1) / align * align;
+
+  template<class Payload>
+  static void apply_payload(void* payload, Registry& r, EventManager& em)
+  {
+    (*static_cast<Payload*>(payload))(r, em);
+  }
+
+  template<class Payload>
+  static void destroy_payload(void* payload)
+  {
+    static_cast<Payload*>(payload)->~Payload();
+  }
+
+  /**
+   * @brief Constructs a command at the end of the arena
+   */
+  template<class Payload, class... Args>
+  void record(Args&&... args)
+  {
+    static_assert(alignof(Payload) <= align,
+                  "over-aligned commands are not supported");
+    std::size_t size = header_size + padded(sizeof(Payload));
+    Block& block = this->reserve(size);
+    std::byte* at = block.data.get() + block.used;
+
+    if constexpr (std::is_aggregate_v<Payload>) {
+      ::new (at + header_size) Payload {std::forward<Args>(args)...};
+    } else {
+      ::new (at + header_size) Payload(std::forward<Args>(args)...);
+    }
+    ::new (at)
+        Header {&apply_payload<Payload>, &destroy_payload<Payload>, size};
+    block.used += size;
+    this->_size += 1;
+  }
+
+  /**
+   * @brief Block with room for size bytes, blocks after _current are empty
+   */
+  Block& reserve(std::size_t size)
+  {
+    for (; this->_current < this->_blocks.size(); this->_current++) {
+      Block& block = this->_blocks[this->_current];
+
+      if (block.capacity - block.used >= size) {
+        return block;
+      }
+    }
+    this->_blocks.emplace_back(std::max(block_size, size));
+    return this->_blocks.back();
+  }
+
+  /**
+   * @brief Forgets the commands, keeps as many blocks as this round used
+   *
+   * Blocks appended from other buffers would otherwise pile up behind the
+   * ones kept from earlier rounds.
+   */
+  void reset()
+  {
+    std::size_t used = 0;
+
+    for (auto& block : this->_blocks) {
+      used += block.used != 0 ? 1 : 0;
+      block.used = 0;
+    }
+    this->_blocks.erase(
+        this->_blocks.begin() + static_cast<std::ptrdiff_t>(used),
+        this->_blocks.end());
+    this->_current = 0;
+    this->_size = 0;
+  }
+
+  std::vector<Block> _blocks;
+  std::size_t _current = 0;  ///< First block that may have room
+  std::size_t _size = 0;
+};
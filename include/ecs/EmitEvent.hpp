@@ -1,6 +1,10 @@
 
 #include <cstdlib>
+#include <format>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <variant>
 
 #include "Json/JsonParser.hpp"
@@ -27,41 +31,52 @@
  * by logging an error instead of crashing.
  *
  * @param r Registry instance to emit the event through
- * @param id Event type identifier (must be registered via Registry::on())
+ * @param id Event type id, see EventManager::find_event_id()
  * @param params JSON object containing event parameters
  *
  * @note This function emits two events:
  *       1. EventBuilder (for network synchronization)
  *       2. The actual event (for local handlers)
- * @note If event ID is unknown, emits a LogEvent with ERROR level
+ * @note If no builder is registered for id, emits a LogEvent with ERROR level
  *
  * @see Registry::emit()
  * @see EventBuilder
  */
 inline void emit_event(EventManager& em,
                        Registry& r,
-                       std::string const& id,
+                       EventTypeId id,
                        JsonObject const& params,
                        std::optional<Ecs::Entity> entity = std::nullopt)
 {
+  // Empty until the id is known to be registered, stable afterwards
+  std::string_view name;
+
   try {
-    em.emit<EventBuilder>(
-        EventBuilder(id, em.get_event_with_id(r, id, params, entity)));
+    name = em.event_name(id);
+    EventBuilder built(std::string(name),
+                       em.get_event_with_id(r, id, params, entity));
+
+    built.local_id = id;
+    em.emit<EventBuilder>(std::move(built));
   } catch (std::out_of_range const&) {
-    em.emit<LogEvent>(
-        "Emit event", LogLevel::ERR, "unknown event: \"" + id + "\"");
+    em.emit<LogEvent>("Emit event",
+                      LogLevel::ERR,
+                      std::format("unknown event: \"{}\" (id {})", name, id));
     return;
   } catch (std::bad_optional_access const&) {
     em.emit<LogEvent>(
         "Emit event",
         LogLevel::ERR,
-        "Bad optional access: missing parameter for event: \"" + id + "\"");
+        std::format("Bad optional access: missing parameter for event: \"{}\"",
+                    name));
     return;
   } catch (std::bad_variant_access const& e) {
     em.emit<LogEvent>(
         "Emit event",
         LogLevel::ERR,
-        "Bad variant access: invalid parameter type for event: \"" + id + "\"");
+        std::format(
+            "Bad variant access: invalid parameter type for event: \"{}\"",
+            name));
     return;
   }
   try {
@@ -70,13 +85,41 @@ inline void emit_event(EventManager& em,
     em.emit<LogEvent>(
         "Emit event",
         LogLevel::ERR,
-        "Bad optional access: missing parameter for event: \"" + id + "\"");
+        std::format("Bad optional access: missing parameter for event: \"{}\"",
+                    name));
   } catch (std::bad_variant_access const& e) {
     em.emit<LogEvent>(
         "Emit event",
         LogLevel::ERR,
-        "Bad variant access: invalid parameter type for event: \"" + id + "\"");
+        std::format(
+            "Bad variant access: invalid parameter type for event: \"{}\"",
+            name));
+  }
+}
+
+/**
+ * @brief Emits an event constructed from JSON parameters, by name
+ *
+ * Resolves the name once and forwards to the EventTypeId overload. Callers
+ * emitting the same event repeatedly can keep the id from
+ * EventManager::find_event_id() instead.
+ *
+ * @note If event ID is unknown, emits a LogEvent with ERROR level
+ */
+inline void emit_event(EventManager& em,
+                       Registry& r,
+                       std::string const& id,
+                       JsonObject const& params,
+                       std::optional<Ecs::Entity> entity = std::nullopt)
+{
+  std::optional<EventTypeId> type = em.find_event_id(id);
+
+  if (!type) {
+    em.emit<LogEvent>(
+        "Emit event", LogLevel::ERR, "unknown event: \"" + id + "\"");
+    return;
   }
+  emit_event(em, r, *type, params, entity);
 }
 
 /**
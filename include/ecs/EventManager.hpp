@@ -44,11 +44,23 @@
  * @see json_buildable in EventConcept.hpp
  */
 
+#include <algorithm>
 #include <any>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <typeindex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Registry.hpp"
+#include "ecs/EventStats.hpp"
 #include "ecs/Events.hpp"
 #include "plugin/Byte.hpp"
 #include "plugin/events/EventConcept.hpp"
@@ -58,6 +70,15 @@
 template<typename T>
 concept event = bytable<T> && entity_convertible<T> && json_buildable<T>;
 
+/**
+ * @brief Dense index of an event type in one EventManager
+ *
+ * Also the interned id of the event name: assigned when the name is
+ * registered, it lets the byte and JSON paths skip the string lookup. Ids
+ * are local to one EventManager, peers exchange their table on connection.
+ */
+using EventTypeId = std::size_t;
+
 class EventManager
 {
 public:
@@ -111,6 +132,7 @@ public:
    *
    * @tparam Event Event type (must satisfy event_type concept)
    * @param handler Callback function taking (const Event&, Registry&)
+   * @param owner Who registers the handler, shown by stats()
    * @return Unique string ID for unregistering this specific handler
    *
    * @note Handler is not invoked immediately - only when emit() is called
@@ -183,30 +205,173 @@ public:
   template<event EventType>
   void on(std::string const& name,
           std::function<bool(const EventType&)> handler,
-          std::size_t priority = 1)
+          std::size_t priority = 1,
+          std::string owner = "")
   {
-    std::type_index type_id(typeid(EventType));
-    _index_getter.insert(type_id, name);
-    if (!_entity_converter.contains(name)) {
-      _entity_converter.insert_or_assign(
-          name,
-          [](ByteArray const& b,
-             std::unordered_map<Ecs::Entity, Ecs::Entity> const& map)
-          { return EventType(b).change_entity(map).to_bytes(); });
+    this->register_event<EventType>(name);
+    this->handlers_of<EventType>().add(
+        Event<EventType>(std::move(handler), priority), std::move(owner));
+  }
+
+  /**
+   * @brief Register a handler receiving events in batches.
+   *
+   * The handler gets every event delivered by one dispatch_queued() call as
+   * a contiguous span, in enqueue order, and walks them in a single pass.
+   * Events passed to emit() reach it as a span of one event.
+   *
+   * Batch and per-event handlers of a type run together by priority, batch
+   * handlers first at equal priority. A batch handler only gets the events
+   * no earlier handler prevented. Returning PREVENT_DEFAULT prevents every
+   * event it got, EventBatch::prevent_default() a single one.
+   *
+   * @tparam EventType Event type (must satisfy event concept)
+   * @param name Event name, as for on()
+   * @param handler Callback taking the batch, as an EventBatch or a span
+   * @param priority Higher values run first
+   * @param owner Who registers the handler, shown by stats()
+   *
+   * @code
+   * em.on_batch<CollisionEvent>(
+   *   "CollisionEvent",
+   *   [&](std::span<CollisionEvent const> collisions) {
+   *     for (auto const& c : collisions) { ... }
+   *     return false;
+   *   });
+   * @endcode
+   *
+   * @see enqueue() and dispatch_queued()
+   */
+  template<event EventType>
+  void on_batch(std::string const& name,
+                std::function<bool(EventBatch<EventType> const&)> handler,
+                std::size_t priority = 1,
+                std::string owner = "")
+  {
+    this->register_event<EventType>(name);
+    this->handlers_of<EventType>().add_batch(
+        Event<EventBatch<EventType>>(std::move(handler), priority),
+        std::move(owner));
+  }
+
+  /**
+   * @brief Queue an event, delivered by the next dispatch_queued<EventType>()
+   *
+   * The event is constructed in place at the end of its type's queue. The
+   * queue keeps its capacity between batches, so enqueueing does not
+   * allocate once warm. Like emit(), nothing is queued while no handler is
+   * registered for the type.
+   *
+   * @tparam EventType Event type to construct
+   * @param args Arguments of the EventType constructor
+   */
+  template<typename EventType, typename... Args>
+  void enqueue(Args&&... args)
+  {
+    HandlerList<EventType>* handlers = this->find_handlers<EventType>();
+
+    if (handlers == nullptr) {
+      return;
+    }
+    std::size_t capacity = handlers->queued.capacity();
+
+    handlers->queued.emplace_back(std::forward<Args>(args)...);
+    if (handlers->recording && handlers->queued.capacity() != capacity) {
+      handlers->stats.queue_allocations += 1;
     }
+  }
+
+  /**
+   * @brief Delivers the queued events of a type, in enqueue order
+   *
+   * Handlers run by priority, batch handlers first at equal priority. A
+   * batch handler receives the events no earlier handler prevented at once,
+   * per-event handlers get them one after the other. Events enqueued while
+   * delivering wait for the next call.
+   *
+   * @tparam EventType Event type whose queue is flushed
+   */
+  template<typename EventType>
+  void dispatch_queued()
+  {
+    HandlerList<EventType>* handlers = this->find_handlers<EventType>();
 
-    if (!_byte_emitter.contains(name)) {
-      _byte_emitter.insert_or_assign(
-          name,
-          [this](ByteArray const& data)
-          { return this->emit<EventType>(EventType(data)); });
+    if (handlers != nullptr) {
+      handlers->dispatch_queued();
     }
+  }
 
+private:
+  /**
+   * @brief Registers the name, the byte and JSON builders of EventType
+   */
+  template<event EventType>
+  void register_event(std::string const& name)
+  {
+    EventTypeId id = this->event_id<EventType>();
+    NamedEvent& named = this->_named[id];
+
+    this->_name_ids.try_emplace(name, id);
+    if (named.name.empty()) {
+      named.name = name;
+    }
+    if (!named.change_entity) {
+      named.change_entity =
+          [](ByteArray const& b,
+             std::unordered_map<Ecs::Entity, Ecs::Entity> const& map)
+      { return EventType(b).change_entity(map).to_bytes(); };
+    }
+    if (!named.emit_bytes) {
+      named.emit_bytes = [this](ByteArray const& data)
+      { this->emit<EventType>(data); };
+    }
     this->add_event_builder<EventType>();
+  }
+
+public:
+  /**
+   * @brief Interned id of EventType, assigned on first use
+   *
+   * @tparam EventType Event type
+   * @return Its EventTypeId in this EventManager
+   */
+  template<typename EventType>
+  EventTypeId event_id()
+  {
+    auto [it, inserted] = this->_event_ids.try_emplace(
+        std::type_index(typeid(EventType)), this->_handlers.size());
 
-    return this->on<EventType>(handler, priority);
+    if (inserted) {
+      this->_handlers.emplace_back();
+      this->_named.emplace_back();
+    }
+    return it->second;
   }
 
+  /**
+   * @brief Id of a registered event name, to resolve once and reuse
+   *
+   * @param name Name given to on()
+   * @return The id, std::nullopt if no event was registered under name
+   */
+  std::optional<EventTypeId> find_event_id(std::string const& name) const;
+
+  /**
+   * @brief Name registered for an event id
+   *
+   * @throws std::out_of_range If id was never assigned
+   */
+  std::string const& event_name(EventTypeId id) const;
+
+  /**
+   * @brief Registered names indexed by EventTypeId
+   *
+   * Types used without a name (emit() only) have an empty entry. This is
+   * the table a server sends to its clients on connection, so both sides
+   * refer to events by id afterwards.
+   */
+  std::vector<std::string> event_names() const;
+
   /**
    * @brief Construct an event from JSON and serialize to binary.
    *
@@ -252,6 +417,16 @@ public:
                               JsonObject const&,
                               std::optional<Ecs::Entity> entity = std::nullopt);
 
+  /**
+   * @brief get_event_with_id() for an id from find_event_id()
+   *
+   * @throws std::out_of_range If no builder is registered for id
+   */
+  ByteArray get_event_with_id(Registry& r,
+                              EventTypeId id,
+                              JsonObject const& params,
+                              std::optional<Ecs::Entity> entity = std::nullopt);
+
   /**
    * @brief Remove all event handlers for a specific event type.
    *
@@ -270,8 +445,11 @@ public:
   template<typename EventType>
   void off_all()
   {
-    std::type_index type_id(typeid(EventType));
-    _handlers.erase(type_id);
+    HandlerList<EventType>* handlers = this->find_handlers<EventType>();
+
+    if (handlers != nullptr) {
+      handlers->clear();
+    }
   }
 
   /**
@@ -306,6 +484,17 @@ public:
             JsonObject const& args,
             std::optional<Ecs::Entity> entity = std::nullopt);
 
+  /**
+   * @brief Emit an event from JSON, by id
+   *
+   * Same as the named overload without the name lookup. Unknown ids are
+   * ignored.
+   */
+  void emit(Registry&,
+            EventTypeId id,
+            JsonObject const& args,
+            std::optional<Ecs::Entity> entity = std::nullopt);
+
   /**
    * @brief Emit an event, invoking all registered handlers.
    *
@@ -323,6 +512,10 @@ public:
    * @note Handlers execute immediately in registration order
    * @note If a handler throws, subsequent handlers may not execute
    * @note Handlers can emit new events (recursive emission supported)
+   * @note Handlers may register or remove handlers of the event being
+   * emitted: the change applies once the outermost emit() of that event
+   * returns, the current dispatch keeps the list it started with. Nothing
+   * is copied nor allocated per call.
    *
    * @code
    * // Notify all handlers that player took damage
@@ -364,22 +557,15 @@ public:
   template<typename EventType, typename... Args>
   void emit(Args&&... args)
   {
-    std::type_index type_id(typeid(EventType));
-    if (!_handlers.contains(type_id)) {
+    HandlerList<EventType>* handlers = this->find_handlers<EventType>();
+
+    if (handlers == nullptr) {
       return;
     }
 
     EventType event(std::forward<Args>(args)...);
 
-    auto handlers_copy =
-        std::any_cast<std::vector<Event<EventType>>>(_handlers.at(type_id));
-
-    for (auto const& handler : handlers_copy) {
-      bool prevent_default = handler(event);
-      if (prevent_default) {
-        break;
-      }
-    }
+    handlers->dispatch(event);
   }
 
   /**
@@ -413,10 +599,18 @@ public:
    */
   void emit(std::string const& name, ByteArray const& data);
 
+  /**
+   * @brief Emit an event from binary representation, by id
+   *
+   * Used for network events, whose id was resolved from the handshake
+   * table. Unknown ids are ignored.
+   */
+  void emit(EventTypeId id, ByteArray const& data);
+
   template<event Event>
   std::string get_event_key()
   {
-    return this->_index_getter.at_first(typeid(Event));
+    return this->event_name(this->_event_ids.at(typeid(Event)));
   }
 
   ByteArray convert_event_entity(
@@ -424,9 +618,417 @@ public:
       ByteArray const& event,
       std::unordered_map<Ecs::Entity, Ecs::Entity> const& map);
 
+  ByteArray convert_event_entity(
+      EventTypeId id,
+      ByteArray const& event,
+      std::unordered_map<Ecs::Entity, Ecs::Entity> const& map);
+
+  /**
+   * @brief Starts or stops recording the metrics returned by stats()
+   *
+   * Recording times every dispatch and every handler call with
+   * std::chrono::steady_clock. Stopping keeps what was recorded.
+   *
+   * @warning Not thread-safe, call it from the thread emitting the events,
+   * like the handlers.
+   */
+  void enable_stats(bool enabled = true);
+
+  bool stats_enabled() const;
+
+  /**
+   * @brief Metrics recorded since enable_stats() or reset_stats()
+   *
+   * One entry per event type having handlers, with its emission count, its
+   * dispatch time histogram and one histogram per handler.
+   */
+  EventStats stats() const;
+
+  /**
+   * @brief Zeroes the recorded counters and histograms
+   */
+  void reset_stats();
+
+  /**
+   * @brief Removes every handler, builder and converter
+   *
+   * @warning Not to be called from a handler, the lists being dispatched
+   * would be destroyed.
+   */
   void delete_all();
 
 private:
+  /**
+   * @brief Type-erased owner of a HandlerList, one per EventTypeId
+   */
+  struct HandlerSlot
+  {
+    HandlerSlot() = default;
+    HandlerSlot(HandlerSlot const&) = delete;
+    HandlerSlot& operator=(HandlerSlot const&) = delete;
+    virtual ~HandlerSlot() = default;
+
+    bool recording = false;  ///< See enable_stats()
+    EventTypeStats stats;  ///< Counters only, handlers are the two below
+    std::vector<HandlerStats> handler_stats;  ///< Parallel to handlers
+    std::vector<HandlerStats> batch_stats;  ///< Parallel to batch_handlers
+  };
+
+  /**
+   * @brief Handlers and queue of one event type, sorted by priority
+   *
+   * dispatch() walks the lists in place. While at least one dispatch of the
+   * type is running, add() and clear() are recorded and applied when the
+   * last one returns, so the lists never change under an iteration.
+   *
+   * queued and spare are swapped at each dispatch_queued(): the batch is
+   * handed out as one contiguous span while new events fill the other
+   * buffer, and both keep their capacity.
+   *
+   * Each handler has a HandlerStats at the same index in the slot, inserted
+   * and removed with it. While recording, calls are timed into it.
+   */
+  template<typename EventType>
+  struct HandlerList : HandlerSlot
+  {
+    void add(Event<EventType> handler, std::string owner)
+    {
+      if (this->dispatching > 0) {
+        this->added.emplace_back(std::move(handler), std::move(owner));
+        return;
+      }
+      insert(this->handlers,
+             this->handler_stats,
+             std::move(handler),
+             std::move(owner));
+    }
+
+    void add_batch(Event<EventBatch<EventType>> handler,
+                   std::string owner)
+    {
+      if (this->dispatching > 0) {
+        this->added_batch.emplace_back(std::move(handler), std::move(owner));
+        return;
+      }
+      insert(this->batch_handlers,
+             this->batch_stats,
+             std::move(handler),
+             std::move(owner));
+    }
+
+    void clear()
+    {
+      if (this->dispatching > 0) {
+        this->cleared = true;
+        this->added.clear();
+        this->added_batch.clear();
+        return;
+      }
+      this->clear_handlers();
+    }
+
+    void dispatch(EventType const& event)
+    {
+      Scope scope(*this);
+
+      this->run(std::span<EventType const>(&event, 1));
+    }
+
+    void dispatch_queued()
+    {
+      if (this->queued.empty()) {
+        return;
+      }
+      // The spare buffer becomes the queue, enqueue() may run meanwhile
+      std::vector<EventType> batch = std::move(this->queued);
+      this->queued = std::move(this->spare);
+      this->queued.clear();
+
+      {
+        Scope scope(*this);
+
+        this->run(batch);
+      }
+      batch.clear();
+      this->spare = std::move(batch);
+    }
+
+    /**
+     * @brief Counts a running dispatch, the last one settles the list
+     */
+    struct Scope
+    {
+      explicit Scope(HandlerList& l)
+          : list(l)
+      {
+        this->list.dispatching += 1;
+      }
+
+      ~Scope()
+      {
+        this->list.dispatching -= 1;
+        if (this->list.dispatching == 0) {
+          this->list.settle();
+        }
+      }
+
+      Scope(Scope const&) = delete;
+      Scope& operator=(Scope const&) = delete;
+
+      HandlerList& list;
+    };
+
+    /**
+     * @brief Delivers events, timed and counted while recording
+     */
+    void run(std::span<EventType const> events)
+    {
+      if (!this->recording) {
+        this->deliver_all(events);
+        return;
+      }
+      auto start = std::chrono::steady_clock::now();
+      std::size_t prevented = this->deliver_all(events);
+
+      this->stats.dispatch_time.record(std::chrono::steady_clock::now()
+                                       - start);
+      this->stats.emitted += events.size();
+      this->stats.dispatches += 1;
+      this->stats.prevented += prevented;
+    }
+
+    /**
+     * @brief Per-event state of one running dispatch, kept for reuse
+     */
+    struct Pass
+    {
+      std::vector<std::uint8_t> prevented;  ///< One flag per event
+      std::size_t live = 0;  ///< Events not prevented yet
+      std::vector<EventType> kept;  ///< Events left for a batch handler
+      std::vector<std::size_t> origin;  ///< Index of each kept event
+    };
+
+    /**
+     * @brief Runs the handlers by priority, batch handlers first on ties
+     *
+     * Consecutive per-event handlers run event by event, as emit() would
+     * call them. An event prevented by any handler skips the later ones.
+     *
+     * @return Number of events whose default a handler prevented
+     */
+    std::size_t deliver_all(std::span<EventType const> events)
+    {
+      // One pass per running dispatch, a handler may dispatch again
+      if (this->passes.size() < this->dispatching) {
+        this->passes.resize(this->dispatching);
+      }
+      Pass& pass = this->passes[this->dispatching - 1];
+      std::size_t batch = 0;
+      std::size_t first = 0;
+
+      pass.prevented.assign(events.size(), 0);
+      pass.live = events.size();
+      while (pass.live > 0
+             && (batch < this->batch_handlers.size()
+                 || first < this->handlers.size()))
+      {
+        if (first == this->handlers.size()
+            || (batch < this->batch_handlers.size()
+                && this->batch_handlers[batch].priority()
+                    >= this->handlers[first].priority()))
+        {
+          this->deliver_batch(events, pass, batch);
+          batch += 1;
+          continue;
+        }
+        std::size_t last = first + 1;
+
+        while (last < this->handlers.size()
+               && (batch == this->batch_handlers.size()
+                   || this->handlers[last].priority()
+                       > this->batch_handlers[batch].priority()))
+        {
+          last += 1;
+        }
+        this->deliver(events, pass, first, last);
+        first = last;
+      }
+      return events.size() - pass.live;
+    }
+
+    /**
+     * @brief Hands the events nobody prevented to one batch handler
+     */
+    void deliver_batch(std::span<EventType const> events,
+                       Pass& pass,
+                       std::size_t at)
+    {
+      std::span<EventType const> kept = events;
+      std::span<std::size_t const> origin;
+
+      if (pass.live != events.size()) {
+        pass.kept.clear();
+        pass.origin.clear();
+        for (std::size_t i = 0; i < events.size(); i++) {
+          if (pass.prevented[i] == 0) {
+            pass.kept.push_back(events[i]);
+            pass.origin.push_back(i);
+          }
+        }
+        kept = pass.kept;
+        origin = pass.origin;
+      }
+      EventBatch<EventType> view(kept, origin, pass.prevented);
+
+      if (this->call(this->batch_handlers[at], view, this->batch_stats[at])) {
+        for (std::size_t i = 0; i < view.size(); i++) {
+          view.prevent_default(i);
+        }
+      }
+      pass.live = static_cast<std::size_t>(
+          std::ranges::count(pass.prevented, std::uint8_t {0}));
+    }
+
+    /**
+     * @brief Runs handlers [first, last) on each event, in event order
+     */
+    void deliver(std::span<EventType const> events,
+                 Pass& pass,
+                 std::size_t first,
+                 std::size_t last)
+    {
+      for (std::size_t e = 0; e < events.size(); e++) {
+        if (pass.prevented[e] != 0) {
+          continue;
+        }
+        for (std::size_t i = first; i < last; i++) {
+          if (this->call(this->handlers[i], events[e], this->handler_stats[i]))
+          {
+            pass.prevented[e] = 1;
+            pass.live -= 1;
+            break;
+          }
+        }
+      }
+    }
+
+    template<typename Handler, typename Arg>
+    bool call(Handler const& handler, Arg const& arg, HandlerStats& stats)
+    {
+      if (!this->recording) {
+        return handler(arg);
+      }
+      auto start = std::chrono::steady_clock::now();
+      bool prevented = handler(arg);
+
+      stats.time.record(std::chrono::steady_clock::now() - start);
+      if (prevented) {
+        stats.prevented += 1;
+      }
+      return prevented;
+    }
+
+    void clear_handlers()
+    {
+      this->handlers.clear();
+      this->batch_handlers.clear();
+      this->handler_stats.clear();
+      this->batch_stats.clear();
+    }
+
+    /**
+     * @brief Applies the add() and clear() recorded during dispatches
+     */
+    void settle()
+    {
+      if (this->cleared) {
+        this->clear_handlers();
+        this->cleared = false;
+      }
+      for (auto& [handler, owner] : this->added) {
+        insert(this->handlers,
+               this->handler_stats,
+               std::move(handler),
+               std::move(owner));
+      }
+      for (auto& [handler, owner] : this->added_batch) {
+        insert(this->batch_handlers,
+               this->batch_stats,
+               std::move(handler),
+               std::move(owner));
+      }
+      this->added.clear();
+      this->added_batch.clear();
+    }
+
+    template<typename Handler>
+    static void insert(std::vector<Handler>& list,
+                       std::vector<HandlerStats>& stats,
+                       Handler handler,
+                       std::string owner)
+    {
+      auto at = std::upper_bound(list.begin(), list.end(), handler);
+
+      stats.insert(stats.begin() + (at - list.begin()),
+                   HandlerStats {
+                       .owner = std::move(owner),
+                       .priority = handler.priority(),
+                       .batch = std::is_same_v<Handler, BatchHandler>,
+                       .prevented = 0,
+                       .time = {},
+                   });
+      list.insert(at, std::move(handler));
+    }
+
+    using BatchHandler = Event<EventBatch<EventType>>;
+
+    std::vector<Event<EventType>> handlers;
+    std::vector<BatchHandler> batch_handlers;
+    std::vector<std::pair<Event<EventType>, std::string>>
+        added;  ///< add() during a dispatch, with the owner
+    std::vector<std::pair<BatchHandler, std::string>> added_batch;
+    std::vector<EventType> queued;  ///< enqueue() since the last batch
+    std::vector<EventType> spare;  ///< Emptied batch, reused as next queue
+    std::size_t dispatching = 0;  ///< Running dispatches, nested included
+    std::deque<Pass> passes;  ///< Indexed by dispatch depth, stable
+    bool cleared = false;  ///< clear() during a dispatch
+  };
+
+  /**
+   * @brief Handlers of EventType, nullptr if none was ever registered
+   *
+   * The EventTypeId is cached per type and per thread, tagged with the
+   * EventManager it came from, like Registry::component_id(). Emitting a
+   * known event costs no hashing.
+   */
+  template<typename EventType>
+  HandlerList<EventType>* find_handlers()
+  {
+    struct Cache
+    {
+      std::uint64_t manager = 0;
+      EventTypeId id = 0;
+    };
+    thread_local Cache cache;
+
+    if (cache.manager != this->_uid) {
+      auto it = this->_event_ids.find(std::type_index(typeid(EventType)));
+
+      if (it == this->_event_ids.end()) {
+        return nullptr;
+      }
+      cache.id = it->second;
+      cache.manager = this->_uid;
+    }
+    return static_cast<HandlerList<EventType>*>(
+        this->_handlers[cache.id].get());
+  }
+
+  /**
+   * @brief Process-unique tag of an EventManager, keys the id caches
+   */
+  static std::uint64_t next_manager_uid();
+
   // ============================================================================
   // EVENT BUILDERS & TEMPLATES
   // ============================================================================
@@ -484,78 +1086,66 @@ private:
   template<event T>
   void add_event_builder()
   {
-    std::type_index type_id(typeid(T));
-
-    _builders.insert_or_assign(
-        type_id,
-        std::function<std::any(
-            Registry&, JsonObject const&, std::optional<Ecs::Entity>)>(
-            [](Registry& r,
-               JsonObject const& e,
-               std::optional<Ecs::Entity> entity) -> std::any
-            { return T(r, e, entity); }));
-
-    _invokers.insert_or_assign(
-        type_id,
-        [](const std::any& handlers_any, const std::any& event_any)
-        {
-          auto& handlers =
-              std::any_cast<const std::vector<Event<T>>&>(handlers_any);
-          auto& event = std::any_cast<const T&>(event_any);
-          for (auto const& handler : handlers) {
-            bool prevent_default = handler(event);
-            if (prevent_default) {
-              break;
-            }
-          }
-        });
+    NamedEvent& named = this->_named[this->event_id<T>()];
 
-    _json_builder.insert_or_assign(type_id,
-                                   [](Registry& r,
-                                      JsonObject const& params,
-                                      std::optional<Ecs::Entity> entity)
-                                   { return T(r, params, entity).to_bytes(); });
+    named.emit_json = [this](Registry& r,
+                             JsonObject const& params,
+                             std::optional<Ecs::Entity> entity)
+    { this->emit<T>(r, params, entity); };
+    named.json_to_bytes = [](Registry& r,
+                             JsonObject const& params,
+                             std::optional<Ecs::Entity> entity)
+    { return T(r, params, entity).to_bytes(); };
   }
 
+  /**
+   * @brief Handlers of EventType, created on first use
+   */
   template<event EventType>
-  void on(std::function<bool(const EventType&)> handler, size_t precision = 1)
+  HandlerList<EventType>& handlers_of()
   {
-    std::type_index type_id(typeid(EventType));
+    auto& slot = this->_handlers[this->event_id<EventType>()];
 
-    // Ensure the vector exists BEFORE trying to get a reference
-    if (!_handlers.contains(type_id)) {
-      _handlers.emplace(type_id, std::vector<Event<EventType>>());
+    if (slot == nullptr) {
+      slot = std::make_unique<HandlerList<EventType>>();
+      slot->recording = this->_recording;
     }
-
-    Event<EventType> tmp(handler, precision);
-
-    // Now safe to get reference using .at() which throws on missing key
-    auto& handlers =
-        std::any_cast<std::vector<Event<EventType>>&>(_handlers.at(type_id));
-    auto insert_pos = std::upper_bound(handlers.begin(), handlers.end(), tmp);
-    handlers.insert(insert_pos, std::move(tmp));
+    return static_cast<HandlerList<EventType>&>(*slot);
   }
 
-  std::unordered_map<std::string,
-                     std::function<ByteArray(
-                         ByteArray const&,
-                         std::unordered_map<Ecs::Entity, Ecs::Entity> const&)>>
-      _entity_converter;
-
-  std::unordered_map<std::string, std::function<void(ByteArray const&)>>
-      _byte_emitter;
-
-  TwoWayMap<std::type_index, std::string> _index_getter;
-  std::unordered_map<std::type_index, std::any> _builders;
+  /**
+   * @brief Name and type-erased entry points of one event type
+   *
+   * Filled by on() and add_event_builder(). The functions are reset by
+   * delete_all(), the name and id stay.
+   */
+  struct NamedEvent
+  {
+    std::string name;
+    std::function<void(ByteArray const&)> emit_bytes;
+    std::function<ByteArray(
+        ByteArray const&, std::unordered_map<Ecs::Entity, Ecs::Entity> const&)>
+        change_entity;
+    std::function<void(
+        Registry&, JsonObject const&, std::optional<Ecs::Entity>)>
+        emit_json;
+    std::function<ByteArray(
+        Registry&, JsonObject const&, std::optional<Ecs::Entity>)>
+        json_to_bytes;
+  };
 
-  std::unordered_map<std::type_index, std::any> _handlers;
-  std::unordered_map<
-      std::type_index,
-      std::function<ByteArray(
-          Registry&, JsonObject const&, std::optional<Ecs::Entity>)>>
-      _json_builder;
+  /**
+   * @brief Entry of id, nullptr if the id was never assigned
+   */
+  NamedEvent const* find_named(EventTypeId id) const;
 
-  std::unordered_map<std::type_index,
-                     std::function<void(const std::any&, const std::any&)>>
-      _invokers;
+  std::uint64_t _uid = next_manager_uid();
+  std::unordered_map<std::type_index, EventTypeId> _event_ids;
+  std::unordered_map<std::string, EventTypeId> _name_ids;
+  std::vector<std::unique_ptr<HandlerSlot>>
+      _handlers;  // Indexed by EventTypeId, nullptr after delete_all()
+  // Indexed by EventTypeId. A deque: handlers run from emit_json or
+  // emit_bytes may assign new ids, the running entry must not move
+  std::deque<NamedEvent> _named;
+  bool _recording = false;  // See enable_stats()
 };
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct LatencyHistogram
+ * @brief Durations bucketed by powers of two, in nanoseconds
+ *
+ * Bucket i counts the durations of bit width i: [2^(i-1), 2^i) ns, bucket 0
+ * holds the zero durations. Recording is a few additions, no allocation,
+ * so it can run on every handler call. Percentiles are read back as the
+ * upper bound of their bucket, at most twice the real value.
+ */
+struct LatencyHistogram
+{
+  static constexpr std::size_t bucket_count = 65;
+
+  std::array<std::uint64_t, bucket_count> buckets {};
+  std::uint64_t count = 0;
+  std::uint64_t total_ns = 0;
+  std::uint64_t max_ns = 0;
+
+  void record(std::chrono::nanoseconds duration)
+  {
+    auto ns = static_cast<std::uint64_t>(
+        std::max(duration.count(), std::chrono::nanoseconds::rep(0)));
+
+    this->buckets[std::bit_width(ns)] += 1;
+    this->count += 1;
+    this->total_ns += ns;
+    this->max_ns = std::max(this->max_ns, ns);
+  }
+
+  /**
+   * @brief Upper bound of the q-th quantile, 0 without samples
+   *
+   * @param q Quantile in [0, 1], 0.99 for the p99
+   */
+  std::uint64_t percentile(double q) const
+  {
+    if (this->count == 0) {
+      return 0;
+    }
+    auto rank = static_cast<std::uint64_t>(
+        std::clamp(q, 0.0, 1.0) * static_cast<double>(this->count - 1));
+    std::uint64_t seen = 0;
+
+    for (std::size_t i = 0; i < bucket_count; i++) {
+      seen += this->buckets[i];
+      if (seen > rank) {
+        // 2^i - 1, wrapping to the maximum for the last bucket
+        std::uint64_t upper =
+            i == 0 ? 0 : ((std::uint64_t {1} << (i - 1)) << 1U) - 1;
+
+        return std::min(upper, this->max_ns);
+      }
+    }
+    return this->max_ns;
+  }
+
+  std::uint64_t mean_ns() const
+  {
+    return this->count == 0 ? 0 : this->total_ns / this->count;
+  }
+};
+
+/**
+ * @struct HandlerStats
+ * @brief Calls and time of one handler registered with EventManager::on()
+ *
+ * @see EventTypeStats
+ */
+struct HandlerStats
+{
+  std::string owner;  ///< Plugin that subscribed, empty if unknown
+  std::size_t priority = 0;
+  bool batch = false;  ///< Registered with on_batch()
+  std::uint64_t prevented = 0;  ///< Calls returning PREVENT_DEFAULT
+  LatencyHistogram time;  ///< One sample per call
+};
+
+/**
+ * @struct EventTypeStats
+ * @brief Emissions and dispatch time of one event type
+ *
+ * A dispatch is one emit() or one dispatch_queued() call, its time covers
+ * every handler it ran, including the events they emitted in turn.
+ *
+ * @see EventStats
+ */
+struct EventTypeStats
+{
+  std::string name;  ///< Name given to EventManager::on()
+  std::size_t id = 0;  ///< EventTypeId in the EventManager
+  std::uint64_t emitted = 0;  ///< Events delivered, queued ones included
+  std::uint64_t dispatches = 0;
+  std::uint64_t prevented = 0;  ///< Events stopped by PREVENT_DEFAULT
+  std::uint64_t queue_allocations = 0;  ///< enqueue() growing the queue
+  LatencyHistogram dispatch_time;
+  std::vector<HandlerStats> handlers;  ///< In call order, by priority
+};
+
+/**
+ * @struct EventStats
+ * @brief Per event type metrics of an EventManager
+ *
+ * Returned by EventManager::stats(). Nothing is recorded until
+ * EventManager::enable_stats() is called: a disabled EventManager only
+ * pays one branch per dispatch.
+ *
+ * @code
+ * em.enable_stats();
+ * // ... run some frames
+ * for (auto const& evt : em.stats().events) {
+ *   if (evt.dispatch_time.percentile(0.99) > 1'000'000) {
+ *     std::cout << evt.name << " p99 above 1ms\n";
+ *   }
+ * }
+ * @endcode
+ */
+struct EventStats
+{
+  bool enabled = false;
+  std::vector<EventTypeStats> events;  ///< Types with handlers, by id
+};
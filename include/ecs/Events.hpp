@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <span>
+#include <vector>
 
 /**
  * @file Events.hpp
@@ -69,6 +73,11 @@ public:
    */
   bool operator()(EventType const& event) const { return this->_fn(event); }
 
+  /**
+   * @brief Execution priority given at construction
+   */
+  std::size_t priority() const { return this->_priority; }
+
   /**
    * @brief Compares events by priority for sorting
    * @param other event to compare against
@@ -86,3 +95,69 @@ private:
   size_t _priority;  ///< Execution priority (public for sorting access)
   std::function<bool(EventType const&)> _fn;  ///< The wrapped event function
 };
+
+/**
+ * @class EventBatch
+ * @brief Events handed to a batch handler, see EventManager::on_batch()
+ *
+ * Converts to std::span<EventType const>, so a handler may take either.
+ * Returning PREVENT_DEFAULT stops every event of the batch,
+ * prevent_default(i) stops event i alone: the handlers after this one do
+ * not see it, the others still do.
+ *
+ * @code
+ * em.on_batch<CollisionEvent>(
+ *   "CollisionEvent",
+ *   [](EventBatch<CollisionEvent> const& batch) {
+ *     for (std::size_t i = 0; i < batch.size(); i++) {
+ *       if (is_absorbed(batch[i])) { batch.prevent_default(i); }
+ *     }
+ *     return false;
+ *   });
+ * @endcode
+ */
+template<typename EventType>
+class EventBatch
+{
+public:
+  /**
+   * @param events Events still delivered, contiguous
+   * @param origin Index of each event in prevented, empty if they match
+   * @param prevented One flag per event of the dispatch
+   */
+  EventBatch(std::span<EventType const> events,
+             std::span<std::size_t const> origin,
+             std::vector<std::uint8_t>& prevented)
+      : _events(events)
+      , _origin(origin)
+      , _prevented(prevented)
+  {
+  }
+
+  operator std::span<EventType const>() const { return this->_events; }
+
+  std::span<EventType const> events() const { return this->_events; }
+
+  auto begin() const { return this->_events.begin(); }
+
+  auto end() const { return this->_events.end(); }
+
+  std::size_t size() const { return this->_events.size(); }
+
+  bool empty() const { return this->_events.empty(); }
+
+  EventType const& operator[](std::size_t i) const { return this->_events[i]; }
+
+  /**
+   * @brief Keeps the i-th event of the batch from the next handlers
+   */
+  void prevent_default(std::size_t i) const
+  {
+    this->_prevented.get()[this->_origin.empty() ? i : this->_origin[i]] = 1;
+  }
+
+private:
+  std::span<EventType const> _events;
+  std::span<std::size_t const> _origin;
+  std::reference_wrapper<std::vector<std::uint8_t>> _prevented;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class OwningGroup
+ * @brief Components whose storages are kept sorted for one set of types
+ *
+ * Owned by the Registry. The entities owning every component of the group
+ * occupy the first size() dense slots of each owned SparseArray, in the
+ * same order, so slot i of every owned storage belongs to the same entity.
+ * The Registry moves entities in and out of that prefix as their components
+ * are added and removed.
+ *
+ * A component type belongs to at most one owning group.
+ *
+ * @see Registry::group()
+ */
+class OwningGroup
+{
+public:
+  /**
+   * @brief Creates an empty group
+   * @param owned Sorted ComponentIds whose storages the group orders
+   */
+  explicit OwningGroup(std::vector<std::size_t> owned)
+      : _owned(std::move(owned))
+  {
+  }
+
+  /**
+   * @brief ComponentIds whose storages the group orders, sorted
+   */
+  std::vector<std::size_t> const& owned() const { return this->_owned; }
+
+  /**
+   * @brief Number of members, packed at the front of each owned storage
+   */
+  std::size_t size() const { return this->_size; }
+
+  void resize(std::size_t size) { this->_size = size; }
+
+private:
+  std::vector<std::size_t> _owned;
+  std::size_t _size = 0;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ecs/Entity.hpp"
+
+/**
+ * @class QueryCache
+ * @brief Entities owning every component of a persistent query
+ *
+ * Owned by the Registry, which inserts and erases entities as their
+ * components are added and removed, so iterating the cache never scans the
+ * component storages. Membership is a sparse set: O(1) insert, erase and
+ * lookup, entities packed in a vector.
+ *
+ * @see Registry::query()
+ */
+class QueryCache
+{
+public:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Creates an empty cache
+   * @param required Sorted ComponentIds an entity must own to be a member
+   */
+  explicit QueryCache(std::vector<std::size_t> required)
+      : _required(std::move(required))
+  {
+  }
+
+  /**
+   * @brief ComponentIds an entity must own to be a member, sorted
+   */
+  std::vector<std::size_t> const& required() const { return this->_required; }
+
+  /**
+   * @brief Member entities, in no particular order
+   */
+  std::vector<Ecs::Entity> const& entities() const { return this->_entities; }
+
+  bool contains(Ecs::Entity e) const
+  {
+    return e < this->_slots.size() && this->_slots[e] != npos;
+  }
+
+  /**
+   * @brief Adds an entity, does nothing if it already is a member
+   */
+  void insert(Ecs::Entity e)
+  {
+    if (this->contains(e)) {
+      return;
+    }
+    if (e >= this->_slots.size()) {
+      this->_slots.resize(e + 1, npos);
+    }
+    this->_slots[e] = this->_entities.size();
+    this->_entities.push_back(e);
+  }
+
+  /**
+   * @brief Removes an entity by moving the last member into its slot
+   */
+  void erase(Ecs::Entity e)
+  {
+    if (!this->contains(e)) {
+      return;
+    }
+    std::size_t slot = this->_slots[e];
+    Ecs::Entity last = this->_entities.back();
+
+    this->_entities[slot] = last;
+    this->_slots[last] = slot;
+    this->_entities.pop_back();
+    this->_slots[e] = npos;
+  }
+
+  /**
+   * @brief Removes every member
+   */
+  void clear()
+  {
+    for (Ecs::Entity e : this->_entities) {
+      this->_slots[e] = npos;
+    }
+    this->_entities.clear();
+  }
+
+private:
+  std::vector<std::size_t> _required;
+  std::vector<Ecs::Entity> _entities;
+  std::vector<std::size_t> _slots;  ///< Indexed by entity, npos if absent
+};
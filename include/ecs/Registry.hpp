@@ -21,7 +21,7 @@
  * Entities are lightweight IDs (size_t) that serve as indices into component
  * arrays. The Registry maintains:
  * - Active entity counter (_max)
- * - Dead entity queue for ID recycling (_dead_entities)
+ * - Dead entity ids for recycling (_dead_entities), see set_id_reuse()
  * - Entities pending deletion (_entities_to_kill)
  *
  * Lifecycle:
@@ -34,6 +34,8 @@
  * @subsection reg_components Component Storage
  *
  * Components are stored in SparseArray<T> containers, one per component type.
+ * Each SparseArray is a sparse set: live components are packed contiguously
+ * and a paged sparse table maps entity ids to their packed slot.
  * Registration creates type-erased storage with helper functions:
  *
  * @code
@@ -45,8 +47,12 @@
  *   typeid(Position) -> SparseArray<Position> (as std::any)
  * }
  *
+ * // Constant-time access (_component_storages):
+ * _component_ids:      typeid -> ComponentId, assigned on first registration
+ * _component_storages: ComponentId -> SparseArray<Position>*
+ *
  * // Helper maps:
- * _delete_functions:  typeid -> lambda to erase component
+ * _delete_functions:  ComponentId -> lambda to erase component
  * _emplace_functions: typeid -> lambda to insert from bytes
  * _state_getters:     typeid -> lambda to serialize state
  * _index_getter:      typeid <-> "Position" string lookup
@@ -75,6 +81,10 @@
  *
  * // Execution order maintained in _frequent_systems vector
  * registry.run_systems(); // Calls in priority order
+ *
+ * // Handles pause, resume and remove systems
+ * SystemId id = registry.add_system([](Registry& r) { ... });
+ * registry.disable_system(id);
  * @endcode
  *
  * @subsection reg_events Event System
@@ -196,16 +206,23 @@
 
 #include <algorithm>
 #include <any>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
-#include <queue>
 #include <random>
+#include <span>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
 #include <unordered_set>
@@ -216,16 +233,38 @@
 #include "Json/JsonParser.hpp"
 #include "SparseArray.hpp"
 #include "TwoWayMap.hpp"
+#include "ecs/ChangeTick.hpp"
 #include "ecs/ComponentState.hpp"
 #include "ecs/Entity.hpp"
+#include "ecs/OwningGroup.hpp"
+#include "ecs/QueryCache.hpp"
+#include "ecs/RegistrySnapshot.hpp"
+#include "ecs/RegistryStats.hpp"
 #include "ecs/Scenes.hpp"
 #include "ecs/Systems.hpp"
+#include "ecs/ThreadPool.hpp"
 #include "plugin/Byte.hpp"
 #include "plugin/HookConcept.hpp"
 #include "plugin/events/EventConcept.hpp"
 
 using Ecs::Entity;
 
+/**
+ * @brief Dense index of a component type inside one Registry
+ *
+ * Assigned by Registry::register_component(), see Registry::component_id().
+ */
+using ComponentId = std::size_t;
+
+/**
+ * @brief Order in which Registry::spawn_entity() recycles dead entity ids
+ */
+enum class IdReusePolicy : std::uint8_t
+{
+  FIFO,  ///< Oldest dead id first (default)
+  LOWEST_FIRST,  ///< Smallest dead id first, keeps the id range compact
+};
+
 /**
  * @concept component
  * @brief Requires a type to be serializable and entity-convertible for network
@@ -265,6 +304,13 @@ template<typename T>
 concept component = bytable<T> && entity_convertible<T>;
 
 class EventManager;
+class CommandBuffer;
+
+template<class... Comps>
+class Query;
+
+template<class... Comps>
+class Group;
 
 /**
  * @brief The Registry class is the core of the ECS (Entity-Component-System)
@@ -307,6 +353,9 @@ class EventManager;
 class Registry
 {
 public:
+  Registry();
+  ~Registry();
+
   /**
    * @brief Registers a bytable component type with a string identifier.
    *
@@ -319,6 +368,8 @@ public:
    * @note Must be called before using the component type
    * @note String ID must be unique across all component types
    * @note Registration is idempotent - re-registering replaces existing
+   * @note Types without data members (tags) get a bitset storage, see the
+   * SparseArray specialization for empty types
    * @see // TODO: Mention Macros
    */
 
@@ -329,16 +380,38 @@ public:
   SparseArray<Component>& register_component(std::string const& string_id)
   {
     std::type_index ti(typeid(Component));
-
-    this->_components.insert_or_assign(ti, SparseArray<Component>());
-    SparseArray<Component>& comp = this->get_components<Component>();
-
-    this->_delete_functions.insert_or_assign(
-        ti, [&comp](Entity const& e) { comp.erase(e); });
+    ComponentId id = this->assign_component_id(ti);
+
+    auto& storage =
+        this->_components
+            .insert_or_assign(ti, SparseArray<Component>(&this->_memory))
+            .first->second;
+    SparseArray<Component>& comp =
+        std::any_cast<SparseArray<Component>&>(storage);
+    this->_component_storages[id] = &comp;
+    comp.set_change_clock(&this->_change_tick);
+
+    this->_delete_functions[id] = [&comp](Entity const& e) { comp.erase(e); };
+    this->_shrink_functions[id] = [&comp]() { comp.shrink_to_fit(); };
+    this->_save_functions[id] = [&comp](std::any& slot)
+    { save_storage(comp, slot); };
+    this->_restore_functions[id] = [this, &comp](std::any const* slot)
+    { this->restore_storage(comp, slot); };
+    this->_stats_functions[id] = [&comp, string_id](ComponentStats& stats)
+    { fill_stats(comp, string_id, stats); };
+    if constexpr (!std::is_empty_v<Component>) {
+      this->_dense_index_functions[id] = [&comp](Entity e)
+      { return comp.dense_index(e); };
+      this->_dense_move_functions[id] = [&comp](Entity e, std::size_t to)
+      { comp.swap_dense(comp.dense_index(e), to); };
+    }
     this->_emplace_functions.insert_or_assign(
         ti,
-        [&comp](Entity const& e, ByteArray const& bytes)
-        { comp.insert_at(e, bytes); });
+        [this, &comp, id](Entity const& e, ByteArray const& bytes)
+        {
+          this->resolve_component(*comp.insert_at(e, bytes));
+          this->mark_component(e, id, true);
+        });
     this->_comp_entity_converters.insert_or_assign(
         string_id,
         [](ByteArray const& b, std::unordered_map<Entity, Entity> const& map)
@@ -348,10 +421,10 @@ public:
         [&comp, string_id]()
         {
           ComponentState r(string_id);
-          for (std::size_t i = 0; i < comp.size(); i++) {
-            if (comp[i]) {
-              r.comps.emplace_back(i, comp[i]->to_bytes());
-            }
+          r.comps.reserve(comp.count());
+          for (std::size_t i = 0; i < comp.count(); i++) {
+            r.comps.emplace_back(comp.entities()[i],
+                                 comp.dense_at(i)->to_bytes());
           }
           return r;
         });
@@ -386,17 +459,25 @@ public:
    * @return SparseArray<Component>& A reference to the sparse array of the
    * specified component type.
    *
-   * @throws std::bad_any_cast if component type not registered
-   * @throws std::out_of_range if component type not found
+   * @throws std::out_of_range if component type not registered
    *
    * @note Component must be registered via register_component() first
    * @note Make sure to use Zipper or ZipperIndex
+   * @note Constant time: the storage is indexed by component_id(), no hashing
+   * once the id is cached for the calling thread
+   * @note In debug builds, throws std::logic_error when called from a
+   * concurrent system that did not declare Component
    */
   template<class Component>
   SparseArray<Component>& get_components()
   {
-    return std::any_cast<SparseArray<Component>&>(
-        this->_components.at(std::type_index(typeid(Component))));
+    auto& storage = *static_cast<SparseArray<Component>*>(
+        this->_component_storages[this->component_id<Component>()]);
+
+#ifndef NDEBUG
+    this->check_system_access(typeid(Component));
+#endif
+    return storage;
   }
 
   /**
@@ -406,8 +487,43 @@ public:
   template<class Component>
   SparseArray<Component> const& get_components() const
   {
-    return std::any_cast<const SparseArray<Component>&>(
-        this->_components.at(std::type_index(typeid(Component))));
+    auto const& storage = *static_cast<SparseArray<Component> const*>(
+        this->_component_storages[this->component_id<Component>()]);
+
+#ifndef NDEBUG
+    this->check_system_access(typeid(Component));
+#endif
+    return storage;
+  }
+
+  /**
+   * @brief Dense id of a registered component type in this Registry
+   *
+   * Ids are assigned by register_component() in registration order and never
+   * change, re-registering a type keeps its id.
+   *
+   * The id is cached per type and per thread, tagged with the Registry it
+   * came from. The cache lives in whichever module instantiates this
+   * function (the executable or a plugin), but the ids themselves are owned
+   * by the Registry, so every module agrees on them.
+   *
+   * @throws std::out_of_range if component type not registered
+   */
+  template<class Component>
+  ComponentId component_id() const
+  {
+    struct Cache
+    {
+      std::uint64_t registry = 0;
+      ComponentId id = 0;
+    };
+    thread_local Cache cache;
+
+    if (cache.registry != this->_uid) {
+      cache.id = this->_component_ids.at(std::type_index(typeid(Component)));
+      cache.registry = this->_uid;
+    }
+    return cache.id;
   }
 
   /**
@@ -451,6 +567,116 @@ public:
                 })()
             && ...);
   }
+  /**
+   * @brief Persistent query over the entities owning every Comp
+   *
+   * The first call for a set of components builds its cache, later calls
+   * (in any order of Comps) reuse it. The Registry keeps every cache up to
+   * date as components are added and removed, so iterating the returned
+   * Query only visits matching entities.
+   *
+   * Defined in ecs/zipper/Query.hpp, include it to call this.
+   *
+   * @tparam Comps Component types to fetch, const for read-only access
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   *
+   * @code
+   * r.query<Position const, Collidable const>().each(
+   *   [&](Entity e, Position const& pos, Collidable const& col) {
+   *     boxes.push_back({e, pos.pos, col.size});
+   *   });
+   * @endcode
+   */
+  template<class... Comps>
+  Query<Comps...> query(SceneState min_scene_level = SceneState::ACTIVE);
+
+  /**
+   * @brief Cache of the entities owning every listed component
+   * @param required ComponentIds, in any order
+   * @return The cache, created and filled on first use
+   */
+  QueryCache& query_cache(std::vector<ComponentId> required);
+
+  /**
+   * @brief Owning group of Comps, the iteration order of their storages
+   *
+   * The first call for a set of components creates the group and sorts the
+   * storages: the entities owning every Comp are moved to the front of each
+   * storage, in the same order. The Registry then keeps them there as
+   * components are added and removed, so iterating the returned Group is a
+   * walk over aligned arrays without any lookup. The storages keep their
+   * usual SparseArray API.
+   *
+   * Defined in ecs/zipper/Group.hpp, include it to call this.
+   *
+   * @note A group pays off when most entities of its storages are members,
+   * Position/Direction/Speed for Moving. Loops led by a rare component
+   * (AttackBehavior, Follower, Spawner...) already walk that storage packed
+   * through Zipper, and cannot own the shared storages a second time.
+   * @note There is no per-signature table storage: every component stays in
+   * its SparseArray, which plugins, hooks and serialization hold directly.
+   * A group is the contiguous layout of one signature within them.
+   *
+   * @tparam Comps Component types to fetch, const for read-only access
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   *
+   * @throws std::logic_error if a Comp is already owned by another group
+   *
+   * @code
+   * r.group<Position, Direction const, Speed const>().each(
+   *   [dt](Entity, Position& pos, Direction const& dir, Speed const& spd)
+   *   { pos.pos += dir.direction * spd.speed * dt; });
+   * @endcode
+   */
+  template<class... Comps>
+  Group<Comps...> group(SceneState min_scene_level = SceneState::ACTIVE);
+
+  /**
+   * @brief Owning group of exactly the given components, see group()
+   * @param owned ComponentIds, in any order
+   * @return The group, created and sorted on first use
+   * @throws std::logic_error if a component is already owned by another
+   * group
+   */
+  OwningGroup& owning_group(std::vector<ComponentId> owned);
+
+  /**
+   * @brief Marks a loop over the storages as running, for its lifetime
+   *
+   * Held by Zipper, ZipperIndex and Group. While one is alive the owning
+   * groups are not reordered, so a loop walking an owned storage in dense
+   * order never sees members swapped under it: an entity completing a group
+   * joins it once the last loop ends, and an entity leaving one empties the
+   * group, which is sorted again at that point.
+   */
+  class LoopScope
+  {
+  public:
+    explicit LoopScope(Registry& r)
+        : _registry(r)
+    {
+      this->_registry._running_loops += 1;
+    }
+
+    LoopScope(LoopScope const& other)
+        : LoopScope(other._registry)
+    {
+    }
+
+    LoopScope& operator=(LoopScope const&) = delete;
+
+    ~LoopScope()
+    {
+      if (--this->_registry._running_loops == 0) {
+        this->_registry.flush_group_moves();
+      }
+    }
+
+  private:
+    Registry& _registry;
+  };
 
   // ========================================================================
   // ENTITY MANAGEMENT
@@ -511,6 +737,75 @@ public:
    */
   Entity spawn_entity();
 
+  /**
+   * @brief Spawns several entities at once
+   *
+   * Recycled IDs are handed out first, like spawn_entity() would, the rest
+   * is a contiguous run of new IDs taken in one step. The entity signatures
+   * are grown once for the whole batch.
+   *
+   * @param count Number of entities to spawn
+   * @return The new entities, in the order spawn_entity() would return them
+   *
+   * @code
+   * std::vector<Entity> enemies = registry.spawn_entities(positions.size());
+   * registry.add_components<Position>(enemies, positions);
+   * @endcode
+   *
+   * @see add_components() to fill their components in batches
+   */
+  std::vector<Entity> spawn_entities(std::size_t count);
+
+  /**
+   * @brief Chooses which dead entity id spawn_entity() hands out next
+   *
+   * FIFO (the default) recycles ids in the order they died. LOWEST_FIRST
+   * always reuses the smallest free id, so live entities gather at the low
+   * end of the id range and the sparse pages of the storages, which are
+   * allocated per range of ids, stay few. Together with shrink_to_fit()
+   * memory then follows the live entity count.
+   *
+   * @param policy The recycling order to use from now on
+   */
+  void set_id_reuse(IdReusePolicy policy);
+
+  /**
+   * @brief Returns unused memory after many entities died
+   *
+   * Forgets the dead ids at the top of the id range, so new entities do
+   * not reach it again, shrinks the entity signatures accordingly and asks
+   * every component storage to release its spare capacity.
+   *
+   * @note Meant for quiet moments (level change, server idle), it walks
+   * every storage and the dead id list.
+   *
+   * @code
+   * registry.set_id_reuse(IdReusePolicy::LOWEST_FIRST);
+   * // ... after a wave is cleared
+   * registry.shrink_to_fit();
+   * @endcode
+   */
+  void shrink_to_fit();
+
+  /**
+   * @brief Pool the component storages of this Registry allocate from
+   *
+   * The dense arrays and sparse pages of the storages are carved from this
+   * pool instead of the global allocator: memory released when entities die
+   * is kept here and handed back to the next ones, in blocks sized for the
+   * storages. What a component allocates itself (strings, JsonObject, maps)
+   * is not covered; components or systems keeping per-entity containers
+   * may allocate them from it through std::pmr containers.
+   *
+   * @note The pool is synchronized, storages may grow from concurrent
+   * systems. It lives as long as the Registry and is released with it.
+   *
+   * @code
+   * std::pmr::vector<Ecs::Entity> targets(&r.memory_resource());
+   * @endcode
+   */
+  std::pmr::memory_resource& memory_resource() { return this->_memory; }
+
   /**
    * @brief Marks an entity for deletion
    *
@@ -591,9 +886,10 @@ public:
    *
    * @details
    * For each entity in _entities_to_kill:
-   * 1. Call delete function for every registered component type
+   * 1. Call the delete function of each component in the entity's signature
    * 2. Add entity ID to _dead_entities queue for recycling
-   * 3. Clear _entities_to_kill set
+   * Then drop the bindings targeting those entities (one pass, skipped when
+   * none of them is bound) and clear the _entities_to_kill set.
    *
    * This is automatically called at the end of run_systems().
    *
@@ -673,8 +969,49 @@ public:
   typename SparseArray<Component>::Ref add_component(Entity const& to,
                                                      Component&& c)
   {
-    return this->get_components<Component>().insert_at(
+    auto& ref = this->get_components<Component>().insert_at(
         to, std::forward<Component>(c));
+    this->resolve_component(*ref);
+    this->mark_component(to, this->component_id<Component>(), true);
+    return ref;
+  }
+
+  /**
+   * @brief Adds a component to many entities in one pass
+   *
+   * Copies components[i] to entities[i]. The storage grows once for the
+   * whole batch instead of once per entity, existing components are
+   * replaced.
+   *
+   * @tparam Component The component type to add
+   * @param entities Entities receiving the components
+   * @param components One component per entity
+   *
+   * @throws std::invalid_argument if the spans differ in size
+   *
+   * @code
+   * std::vector<Speed> speeds(enemies.size(), Speed(-2.0, 0.0));
+   * registry.add_components<Speed>(enemies, speeds);
+   * @endcode
+   *
+   * @see spawn_entities() to allocate the entities in one step
+   */
+  template<component Component>
+  void add_components(std::span<Entity const> entities,
+                      std::span<Component const> components)
+  {
+    if (entities.size() != components.size()) {
+      throw std::invalid_argument(
+          "Registry::add_components: one component per entity expected");
+    }
+    auto& storage = this->get_components<Component>();
+    ComponentId id = this->component_id<Component>();
+
+    storage.insert_range(entities, components);
+    for (Entity e : entities) {
+      this->resolve_component(*storage[e]);
+      this->mark_component(e, id, true);
+    }
   }
 
   /**
@@ -725,8 +1062,11 @@ public:
   typename SparseArray<Component>::Ref emplace_component(Entity const& to,
                                                          Params&&... p)
   {
-    return this->get_components<Component>().insert_at(
+    auto& ref = this->get_components<Component>().insert_at(
         to, std::forward<Params>(p)...);
+    this->resolve_component(*ref);
+    this->mark_component(to, this->component_id<Component>(), true);
+    return ref;
   }
 
   /**
@@ -787,8 +1127,9 @@ public:
    * @param from The entity to remove the component from
    *
    * @details
-   * Sets the SparseArray slot to std::nullopt. The entity remains valid
-   * and can still have other component types.
+   * Removes the entity from the SparseArray (the last packed component is
+   * moved into its slot). The entity remains valid and can still have other
+   * component types.
    *
    * @note Safe to call on entities without the component
    * @note Component type must be registered (or bad_any_cast thrown)
@@ -820,7 +1161,11 @@ public:
     if (!this->has_component<Component>(from)) {
       return;
     }
+    ComponentId id = this->component_id<Component>();
+
+    this->leave_group(from, id);
     this->get_components<Component>().erase(from);
+    this->mark_component(from, id, false);
   }
 
   /**
@@ -829,18 +1174,166 @@ public:
    * @tparam Components: The types of the components the system will operate on.
    * @tparam Function The type of the function representing the system.
    * @param f The function representing the system.
+   * @return Handle to enable, disable or remove the system
    */
   template<class... Components, typename Function>
-  void add_system(Function&& f, std::size_t priority = 0)
+  SystemId add_system(Function&& f, std::size_t priority = 0)
   {
-    System<> sys([this, f = std::forward<Function>(f)]()
+    return this->insert_system(
+        System<>([this, f = std::forward<Function>(f)]()
                  { f(*this, this->get_components<Components>()...); },
-                 priority);
-    auto it = std::upper_bound(
-        this->_frequent_systems.begin(), this->_frequent_systems.end(), sys);
-    this->_frequent_systems.insert(it, std::move(sys));
+                 priority));
   }
 
+  /**
+   * @brief Adds a system that may run in parallel with other systems.
+   *
+   * Components listed as const are only read, the others are written. The
+   * system receives `SparseArray<T> const&` for read components and
+   * `SparseArray<T>&` for written ones. During run_systems(), systems of the
+   * same priority whose declarations do not conflict run at the same time on
+   * the worker pool, in an order compatible with their insertion order.
+   *
+   * @tparam Components Component types the system accesses (const = read)
+   * @tparam Function System function type (deduced)
+   * @param f The system function - signature: void(Registry&, storages...)
+   * @param priority Execution priority (higher values run first, default: 0)
+   * @return Handle to enable, disable or remove the system
+   *
+   * @warning The system must only touch the components it declares, debug
+   * builds throw std::logic_error from get_components() otherwise. Events,
+   * spawning or killing entities and adding or removing components are not
+   * thread-safe: record them with commands(). The Scene storage and the
+   * scene masks can always be read, so Zipper may be used freely.
+   *
+   * @code
+   * registry.add_concurrent_system<Health>(
+   *   [](Registry& r, SparseArray<Health>&) {
+   *     for (auto&& [health] : Zipper<Health>(r)) {
+   *       health.heal_delta += r.clock().delta_seconds();
+   *     }
+   *   },
+   *   2);
+   * @endcode
+   *
+   * @see add_system() for systems with unrestricted access
+   * @see SystemAccess for the conflict rules
+   */
+  template<class... Components, typename Function>
+  SystemId add_concurrent_system(Function&& f, std::size_t priority = 0)
+  {
+    SystemAccess access;
+
+    access.exclusive = false;
+    (this->declare_access<Components>(access), ...);
+    return this->insert_system(System<>(
+        [this, f = std::forward<Function>(f)]()
+        { f(*this, this->system_storage<Components>()...); },
+        priority,
+        std::move(access)));
+  }
+
+  /**
+   * @brief Worker pool shared by parallel systems and parallel iteration.
+   *
+   * Threads are only started the first time the pool is needed.
+   */
+  ThreadPool& workers();
+
+  /**
+   * @brief Runs task(i) for every i in [0, count) on the worker pool.
+   *
+   * Actions passed to defer() by a task are queued per index and executed on
+   * the calling thread once every task returned, in index order, so the
+   * result does not depend on how the work was split between threads.
+   *
+   * @param count Number of indices to process
+   * @param task Function called once per index, possibly concurrently
+   *
+   * @see ZipperIndex::par_each() for per-entity parallel loops
+   */
+  void run_parallel(std::size_t count,
+                    std::function<void(std::size_t)> const& task);
+
+  /**
+   * @brief Delays an action until the current parallel job is over.
+   *
+   * Inside run_parallel() (concurrent systems, par_each()), the action is
+   * queued and executed on the calling thread after the job. Anywhere else it
+   * is executed immediately. Use it for everything that is not safe to do
+   * concurrently: emitting events, spawning, killing, adding or removing
+   * components.
+   *
+   * @param action The action to run
+   *
+   * @code
+   * ZipperIndex<Position, Speed>(r).par_each(
+   *   [&](std::size_t e, Position& pos, Speed& speed) {
+   *     pos.pos += speed.speed * dt;
+   *     r.defer([&em, e, bytes = pos.to_bytes()]() {
+   *       em.emit<ComponentBuilder>(e, "Position", bytes);
+   *     });
+   *   });
+   * @endcode
+   */
+  void defer(std::function<void()> action);
+
+  /**
+   * @brief Command buffer of the running code.
+   *
+   * Inside run_parallel() each task records into its own buffer, handed to
+   * the caller's buffer in index order once the job is over. Anywhere else
+   * this is the Registry's buffer, applied by run_systems() after each batch
+   * of systems or by apply_commands().
+   *
+   * @code
+   * ZipperIndex<Position const>(r).par_each(
+   *   [&r](std::size_t e, Position const& pos) {
+   *     if (pos.pos.x < 0) {
+   *       r.commands().kill(e);
+   *     }
+   *   });
+   * @endcode
+   *
+   * @see CommandBuffer (include ecs/CommandBuffer.hpp to record)
+   */
+  CommandBuffer& commands();
+
+  /**
+   * @brief Applies the commands recorded in the Registry's buffer.
+   */
+  void apply_commands(EventManager& em);
+
+  /**
+   * @brief Tick stamped on the component writes happening now.
+   *
+   * Every SparseArray of this Registry stamps insertions and tracked writes
+   * (SparseArray::modify(), mutable Zipper access) with this tick. It grows
+   * after each batch of systems run by run_systems().
+   *
+   * Code running outside of systems can save it and later pass it to a
+   * Zipper or ZipperIndex to see what changed in between:
+   * @code
+   * ChangeTick last_sync = r.change_tick();
+   * // ... next frame
+   * for (auto&& [e, pos] : ZipperIndex<Changed<Position const>>(r, last_sync))
+   * {
+   *   send_position(e, pos);
+   * }
+   * last_sync = r.change_tick();
+   * @endcode
+   */
+  ChangeTick change_tick() const { return this->_change_tick; }
+
+  /**
+   * @brief Default threshold of Changed and Added filters.
+   *
+   * Inside a system: one past the tick of the system's previous run, so each
+   * change is seen exactly once by every system. Elsewhere: 0, every
+   * component passes the filters.
+   */
+  ChangeTick changes_since() const;
+
   // ========================================================================
   // SYSTEM MANAGEMENT
   // ========================================================================
@@ -944,9 +1437,64 @@ public:
    * @see run_systems() to execute all registered systems
    * @see Zipper for entity iteration
    * @see System class for wrapper details
+   * @see add_concurrent_system() for systems that can run in parallel
    */
   void run_systems(EventManager&);
 
+  /**
+   * @brief Resumes a system paused with disable_system()
+   * @param id Handle returned when the system was added
+   * @note Unknown or removed ids are ignored
+   */
+  void enable_system(SystemId id);
+
+  /**
+   * @brief Pauses a system, run_systems() stops calling it
+   *
+   * Takes effect immediately, even for a system later in the current frame.
+   * A disabled system costs nothing per frame: it is left out of the
+   * schedule until enabled again.
+   *
+   * @param id Handle returned when the system was added
+   * @note Unknown or removed ids are ignored
+   */
+  void disable_system(SystemId id);
+
+  /**
+   * @brief Checks whether a system exists and is enabled
+   * @param id Handle returned when the system was added
+   * @return false for disabled, removed or unknown systems
+   */
+  bool is_system_enabled(SystemId id) const;
+
+  /**
+   * @brief Unregisters a system
+   *
+   * The system is not called anymore from now on. Its function (and what it
+   * captured) is destroyed right away outside of run_systems(), or at the
+   * start of the next frame when removed by a running system.
+   *
+   * @param id Handle returned when the system was added
+   * @note Unknown or already removed ids are ignored
+   */
+  void remove_system(SystemId id);
+
+  /**
+   * @brief Only runs a system while a scene is at least ACTIVE
+   *
+   * The check is a lookup in the scene masks done once per frame, systems of
+   * a disabled scene are skipped without being called.
+   *
+   * @param id Handle returned when the system was added
+   * @param scene_name Scene gating the system, interned if needed
+   *
+   * @code
+   * auto id = registry.add_system([](Registry& r) { update_menu(r); });
+   * registry.bind_system_to_scene(id, "main_menu");
+   * @endcode
+   */
+  void bind_system_to_scene(SystemId id, std::string const& scene_name);
+
   /**
    * @brief Updates all registered dynamic bindings
    *
@@ -1158,6 +1706,7 @@ public:
       }
     };
 
+    this->_binding_counts[entity] += 1;
     _bindings.emplace_back(entity,
                            ti,
                            field_name,
@@ -1577,10 +2126,35 @@ public:
    * @brief Get the scene states map.
    *
    * @return Unordered map of scene names to their states
-   * @note Used internally by Zipper for scene level filtering
+   * @note Zipper filters through get_scene_masks() instead
    */
   std::unordered_map<std::string, SceneState> const& get_scene_states() const;
 
+  /**
+   * @brief Get the integer id of a scene name, assigning one if needed.
+   *
+   * Ids are dense and local to this Registry. Interning a name does not
+   * register the scene: until add_scene() or activate_scene() runs, its mask
+   * stays empty and Zipper skips its entities.
+   *
+   * @param scene_name Name of the scene
+   * @return The SceneId of scene_name
+   * @note Scene components get their id set automatically when added
+   */
+  SceneId intern_scene(std::string_view scene_name);
+
+  /**
+   * @brief Get the level mask of every interned scene, indexed by SceneId.
+   *
+   * Bit N of a mask is set when the scene state is at least SceneState(N)
+   * (see scene_level_mask()), scenes that were never registered have an
+   * empty mask.
+   *
+   * @return Vector of masks indexed by SceneId
+   * @note Used internally by Zipper for scene level filtering
+   */
+  std::vector<std::uint8_t> const& get_scene_masks() const;
+
   /**
    * @brief Get list of currently active scene names (ordered).
    *
@@ -2201,7 +2775,338 @@ public:
 
   ByteArray get_byte_entity(Entity entity);
 
+  /**
+   * @brief Captures every registered storage and the entity allocation state
+   *
+   * Saves the components, the entity signatures, the id counter, the dead
+   * and dying entities and the clock. Trivially copyable components are
+   * copied in bulk, the others through their to_bytes().
+   *
+   * @return A snapshot for restore()
+   *
+   * @code
+   * RegistrySnapshot level_start = registry.snapshot();
+   * // ... player dies
+   * registry.restore(level_start);
+   * @endcode
+   */
+  RegistrySnapshot snapshot() const;
+
+  /**
+   * @brief Captures the Registry into an existing snapshot
+   *
+   * Reuses the buffers of into, meant for snapshots taken every tick.
+   */
+  void snapshot(RegistrySnapshot& into) const;
+
+  /**
+   * @brief Puts the Registry back in the state captured by snapshot()
+   *
+   * Storages registered after the snapshot are emptied. Query caches are
+   * rebuilt from the restored signatures.
+   *
+   * @param snap A snapshot taken from this Registry
+   *
+   * @throws std::invalid_argument if snap was not taken from this Registry
+   *
+   * @note The bindings and the change tick are not part of the snapshot.
+   * Restored components keep the ticks they had when captured, Changed<T>
+   * filters do not report the rollback.
+   */
+  void restore(RegistrySnapshot const& snap);
+
+  /**
+   * @brief Reports the entity, storage and hook counts and their memory
+   *
+   * Walks every registered storage. serialized_bytes serializes the
+   * components that are not trivially copyable, so call it from
+   * diagnostics, not every frame.
+   *
+   * @code
+   * RegistryStats stats = registry.stats();
+   * std::cout << stats.live_entities << " entities, "
+   *           << stats.component_bytes() << " bytes of components\n";
+   * @endcode
+   *
+   * @see RegistryStats
+   */
+  RegistryStats stats() const;
+
 private:
+  /**
+   * @brief Id of a component type, a new one on its first registration
+   */
+  ComponentId assign_component_id(std::type_index type);
+
+  /**
+   * @brief Sets or clears the bit of a component in an entity's signature
+   *
+   * The signature lets process_entity_deletions() erase only the components
+   * an entity owns instead of calling every registered eraser.
+   */
+  void mark_component(Entity e, ComponentId id, bool present);
+
+  /**
+   * @brief Removes a component type from every signature and query cache
+   *
+   * Called when a type is registered again, its storage is then empty.
+   */
+  void forget_component(ComponentId id);
+
+  /**
+   * @brief Checks an entity's signature against a query's components
+   */
+  bool has_signature(Entity e, std::vector<ComponentId> const& ids) const;
+
+  /**
+   * @brief Copies a storage into a snapshot slot, reusing its buffers
+   *
+   * Trivially copyable components keep a copy of the whole SparseArray, the
+   * others a list of (entity, bytes).
+   */
+  template<class Component>
+  static void save_storage(SparseArray<Component> const& comp, std::any& slot)
+  {
+    if constexpr (std::is_trivially_copyable_v<Component>) {
+      if (auto* saved = std::any_cast<SparseArray<Component>>(&slot)) {
+        *saved = comp;
+      } else {
+        slot = comp;
+      }
+    } else {
+      using Saved = std::vector<std::pair<Entity, ByteArray>>;
+      auto* saved = std::any_cast<Saved>(&slot);
+
+      if (saved == nullptr) {
+        saved = &slot.emplace<Saved>();
+      }
+      saved->clear();
+      saved->reserve(comp.count());
+      for (std::size_t i = 0; i < comp.count(); i++) {
+        saved->emplace_back(comp.entities()[i], comp.dense_at(i)->to_bytes());
+      }
+    }
+  }
+
+  /**
+   * @brief Replaces a storage by a snapshot slot, empties it if slot is null
+   */
+  template<class Component>
+  void restore_storage(SparseArray<Component>& comp, std::any const* slot)
+  {
+    bool saved = slot != nullptr && slot->has_value();
+
+    if constexpr (std::is_trivially_copyable_v<Component>) {
+      comp = saved ? std::any_cast<SparseArray<Component> const&>(*slot)
+                   : SparseArray<Component>();
+      comp.set_change_clock(&this->_change_tick);
+    } else {
+      comp = SparseArray<Component>();
+      comp.set_change_clock(&this->_change_tick);
+      if (!saved) {
+        return;
+      }
+      using Saved = std::vector<std::pair<Entity, ByteArray>>;
+      auto const& components = std::any_cast<Saved const&>(*slot);
+
+      comp.reserve(components.size());
+      for (auto const& [e, bytes] : components) {
+        this->resolve_component(*comp.insert_at(e, bytes));
+      }
+    }
+  }
+
+  /**
+   * @brief Fills the ComponentStats of a storage, see stats()
+   */
+  template<class Component>
+  static void fill_stats(SparseArray<Component> const& comp,
+                         std::string const& name,
+                         ComponentStats& stats)
+  {
+    stats.name = name;
+    stats.live = comp.count();
+    stats.capacity = comp.capacity();
+    stats.storage_bytes = comp.memory_usage();
+    stats.serialized_bytes = 0;
+    stats.tag = std::is_empty_v<Component>;
+    if constexpr (!std::is_trivially_copyable_v<Component>) {
+      for (std::size_t i = 0; i < comp.count(); i++) {
+        stats.serialized_bytes += comp.dense_at(i)->to_bytes().size();
+      }
+    }
+  }
+
+  /**
+   * @brief Refills a query cache from the entity signatures
+   */
+  void fill_query(QueryCache& cache) const;
+
+  /**
+   * @brief Sorts the owned storages again, from the entity signatures
+   */
+  void fill_group(OwningGroup& group);
+
+  /**
+   * @brief Checks whether an entity is packed in the prefix of a group
+   */
+  bool in_group(OwningGroup const& group, Entity e) const;
+
+  /**
+   * @brief Moves an entity owning every component into a group's prefix
+   */
+  void enter_group(OwningGroup& group, Entity e);
+
+  /**
+   * @brief Moves an entity out of the prefix of the group owning a component
+   *
+   * Must run before the component is erased, so that the swap and pop of
+   * the erase does not pull a non-member into the prefix.
+   */
+  void leave_group(Entity e, ComponentId id);
+
+  /**
+   * @brief Applies the group moves deferred while loops were running
+   */
+  void flush_group_moves();
+
+  /**
+   * @brief Next dead id to recycle, following _id_reuse
+   */
+  Entity take_dead_entity();
+
+  /**
+   * @brief Makes a dead id available to spawn_entity()
+   */
+  void release_entity(Entity e);
+
+  /**
+   * @brief Process-unique tag of a Registry, keys the component_id() caches
+   */
+  static std::uint64_t next_registry_uid();
+
+  /**
+   * @brief Fills the registry-local fields of a freshly inserted component.
+   *
+   * Only Scene has such a field for now: its scene_name is interned so Zipper
+   * can filter on an integer id.
+   */
+  template<typename Component>
+  void resolve_component(Component& c)
+  {
+    if constexpr (std::is_same_v<Component, Scene>) {
+      c.id = this->intern_scene(c.scene_name);
+    }
+  }
+
+  /**
+   * @brief Gives a system its handle and schedules it.
+   *
+   * Systems added while run_systems() is running are parked until the next
+   * frame so the list being iterated never moves.
+   */
+  SystemId insert_system(System<>&& sys)
+  {
+    sys._id = this->_next_system_id++;
+    SystemId id = sys._id;
+
+    if (this->_running_systems) {
+      this->_added_systems.push_back(std::move(sys));
+    } else {
+      this->place_system(std::move(sys));
+    }
+    return id;
+  }
+
+  /**
+   * @brief Inserts a system at its priority and invalidates the schedule.
+   */
+  void place_system(System<>&& sys)
+  {
+    auto it = std::upper_bound(
+        this->_frequent_systems.begin(), this->_frequent_systems.end(), sys);
+    this->_frequent_systems.insert(it, std::move(sys));
+    this->_systems_dirty = true;
+  }
+
+  /**
+   * @brief Finds a registered system, parked ones included.
+   * @return The system, or nullptr if the id is unknown or removed
+   */
+  System<>* find_system(SystemId id);
+
+  /**
+   * @brief Applies the changes made to the system list since last frame.
+   *
+   * Places parked systems, erases removed ones and rebuilds the schedule if
+   * needed. Does nothing (and allocates nothing) when the list is unchanged.
+   */
+  void flush_systems();
+
+  /**
+   * @brief Calls a scheduled system unless it is disabled or its scene is not
+   * active.
+   *
+   * Records the current change tick as the system's last run, changes_since()
+   * answers for the system while it runs.
+   */
+  void run_system(System<>& sys);
+
+  /**
+   * @brief Records a component of a concurrent system as read or written.
+   */
+  template<class Component>
+  static void declare_access(SystemAccess& access)
+  {
+    std::type_index ti(typeid(std::remove_const_t<Component>));
+
+    if constexpr (std::is_const_v<Component>) {
+      access.reads.push_back(ti);
+    } else {
+      access.writes.push_back(ti);
+    }
+  }
+
+  /**
+   * @brief Storage handed to a concurrent system, const for read components.
+   */
+  template<class Component>
+  auto& system_storage()
+  {
+    if constexpr (std::is_const_v<Component>) {
+      return std::as_const(
+          this->get_components<std::remove_const_t<Component>>());
+    } else {
+      return this->get_components<Component>();
+    }
+  }
+
+  /**
+   * @brief Throws if a concurrent system runs on this thread and did not
+   * declare the component.
+   *
+   * The Scene storage is always allowed. Only called in debug builds, by
+   * get_components().
+   *
+   * @throws std::logic_error naming the undeclared component
+   */
+  void check_system_access(std::type_index const& type) const;
+
+  /**
+   * @brief Groups the systems into batches that can run at the same time.
+   *
+   * Each priority band is scheduled on its own. A system goes in the first
+   * batch after every earlier system of its band it conflicts with, so
+   * conflicting systems keep their insertion order. Disabled systems are left
+   * out.
+   */
+  void plan_systems();
+
+  /**
+   * @brief Sets a registered scene state and keeps its level mask in sync.
+   */
+  void set_scene_state(std::string const& scene_name, SceneState state);
+
   struct Binding
   {
     Entity target_entity;  ///< Entity containing the target component
@@ -2251,9 +3156,38 @@ private:
     }
   };
 
+  std::pmr::synchronized_pool_resource _memory;  // Outlives the storages
   std::unordered_map<std::type_index, std::any> _components;
-  std::unordered_map<std::type_index, std::function<void(Entity const&)>>
-      _delete_functions;
+  std::unordered_map<std::type_index, ComponentId> _component_ids;
+  std::vector<void*> _component_storages;  // Indexed by ComponentId
+  std::uint64_t _uid = next_registry_uid();
+  std::vector<std::function<void(Entity const&)>>
+      _delete_functions;  // Indexed by ComponentId
+  std::vector<std::function<void()>>
+      _shrink_functions;  // Indexed by ComponentId
+  std::vector<std::function<void(std::any&)>>
+      _save_functions;  // Indexed by ComponentId
+  std::vector<std::function<void(std::any const*)>>
+      _restore_functions;  // Indexed by ComponentId, nullptr clears
+  std::vector<std::function<void(ComponentStats&)>>
+      _stats_functions;  // Indexed by ComponentId
+  std::vector<std::function<std::size_t(Entity)>>
+      _dense_index_functions;  // Indexed by ComponentId, empty for tags
+  std::vector<std::function<void(Entity, std::size_t)>>
+      _dense_move_functions;  // Indexed by ComponentId, empty for tags
+  std::vector<std::unique_ptr<OwningGroup>> _groups;
+  std::vector<OwningGroup*>
+      _group_of_component;  // Indexed by ComponentId, nullptr if not owned
+  std::atomic<std::size_t> _running_loops = 0;  // Live LoopScopes
+  std::vector<std::pair<OwningGroup*, Entity>>
+      _deferred_group_entries;  // Joins held back by a running loop
+  std::vector<OwningGroup*> _groups_to_sort;  // Emptied by a running loop
+  std::vector<std::uint64_t>
+      _component_masks;  // _mask_words words per entity, bit = ComponentId
+  std::size_t _mask_words = 0;
+  std::map<std::vector<ComponentId>, std::unique_ptr<QueryCache>> _queries;
+  std::vector<std::vector<QueryCache*>>
+      _queries_by_component;  // Indexed by ComponentId
   std::unordered_map<std::type_index,
                      std::function<void(Entity const&, ByteArray const&)>>
       _emplace_functions;
@@ -2274,7 +3208,18 @@ private:
       _comp_entity_converters;
 
   std::vector<System<>> _frequent_systems;
-  std::queue<Entity> _dead_entities;
+  std::vector<System<>>
+      _added_systems;  // Added during run_systems(), placed next frame
+  std::vector<std::vector<std::size_t>>
+      _system_batches;  // Indices in _frequent_systems, run batch by batch
+  bool _systems_dirty = false;
+  bool _running_systems = false;
+  SystemId _next_system_id = 0;
+  ChangeTick _change_tick = 1;  // 0 is older than any write
+  std::unique_ptr<ThreadPool> _workers;
+  std::unique_ptr<CommandBuffer> _commands;
+  std::deque<Entity> _dead_entities;  // Min-heap under LOWEST_FIRST
+  IdReusePolicy _id_reuse = IdReusePolicy::FIFO;
   std::unordered_set<Entity> _entities_to_kill;
   Clock _clock;
   std::size_t _max = 0;
@@ -2283,6 +3228,19 @@ private:
   std::vector<std::string> _current_scene;
   std::unordered_set<std::string> _active_scenes_set;  // O(1) lookup for Zipper
   std::list<std::string> _main_scene;
+  // Transparent, so that pmr Scene names are looked up without a copy
+  struct SceneNameHash
+  {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view name) const
+    {
+      return std::hash<std::string_view> {}(name);
+    }
+  };
+  std::unordered_map<std::string, SceneId, SceneNameHash, std::equal_to<>>
+      _scene_ids;
+  std::vector<std::uint8_t> _scene_masks;  // Indexed by SceneId, for Zipper
 
   std::unordered_map<std::string,
                      std::function<std::optional<std::any>(std::string const&)>>
@@ -2291,6 +3249,8 @@ private:
                      std::function<std::optional<std::any>(std::string const&)>>
       _global_hooks;
   std::vector<Binding> _bindings;
+  std::unordered_map<Entity, std::size_t>
+      _binding_counts;  // Bindings per target entity, skips scans on death
 
   struct TemplateDefinition
   {
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+#include "Clock.hpp"
+#include "ecs/Entity.hpp"
+
+/**
+ * @class RegistrySnapshot
+ * @brief Copy of a Registry's entities and components at one point in time
+ *
+ * Taken by Registry::snapshot() and put back by Registry::restore(). It is
+ * opaque on purpose: it only makes sense for the Registry that produced it,
+ * whose component ids index the saved storages.
+ *
+ * Storages of trivially copyable components are kept as plain copies of
+ * their SparseArray, which copies their packed arrays in bulk. The other
+ * components are kept as (entity, to_bytes()) pairs.
+ *
+ * @note Keep a snapshot around and pass it to Registry::snapshot() again to
+ * reuse its buffers when checkpointing every tick.
+ */
+class RegistrySnapshot
+{
+public:
+  /**
+   * @brief true until filled by Registry::snapshot()
+   */
+  bool empty() const { return this->_registry_uid == 0; }
+
+private:
+  friend class Registry;
+
+  std::uint64_t _registry_uid = 0;
+  std::vector<std::any> _storages;  ///< Indexed by ComponentId
+  std::vector<std::uint64_t> _component_masks;
+  std::size_t _mask_words = 0;
+  std::size_t _max = 0;
+  std::deque<Ecs::Entity> _dead_entities;
+  std::unordered_set<Ecs::Entity> _entities_to_kill;
+  Clock _clock;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ComponentStats
+ * @brief Occupancy and memory of one component storage
+ *
+ * @see RegistryStats
+ */
+struct ComponentStats
+{
+  std::string name;  ///< Key given to Registry::register_component()
+  std::size_t id = 0;  ///< ComponentId in the Registry
+  std::size_t live = 0;  ///< Entities owning the component
+  std::size_t capacity = 0;  ///< Components held without growing
+  std::size_t storage_bytes = 0;  ///< Dense arrays and sparse pages
+  /**
+   * Total size of the components' to_bytes(), what a full sync of the
+   * storage would send. Not their heap memory: a JsonObject or a map owns
+   * more than its serialized form. 0 for trivially copyable types.
+   */
+  std::size_t serialized_bytes = 0;
+  bool tag = false;  ///< Stored as a bitset, see SparseArray<Tag>
+  bool grouped = false;  ///< Owned by an OwningGroup
+};
+
+/**
+ * @struct RegistryStats
+ * @brief Counts and memory of a Registry at one point in time
+ *
+ * Returned by Registry::stats(), meant for diagnostics and capacity
+ * planning: which storage grows on a long-running server, how much of it is
+ * spare capacity, how many ids wait for reuse.
+ *
+ * @code
+ * RegistryStats stats = registry.stats();
+ * for (auto const& comp : stats.components) {
+ *   if (comp.capacity > 4 * comp.live) {
+ *     std::cout << comp.name << " mostly empty\n";
+ *   }
+ * }
+ * @endcode
+ */
+struct RegistryStats
+{
+  std::size_t live_entities = 0;  ///< Spawned and not dead yet
+  std::size_t entity_ids = 0;  ///< Ids handed out so far (highest + 1)
+  std::size_t dead_ids = 0;  ///< Ids waiting for reuse
+  std::size_t pending_kills = 0;  ///< Killed, erased at the end of the frame
+  std::size_t signature_bytes = 0;  ///< Component masks of the entities
+  std::size_t systems = 0;  ///< Registered systems, enabled or not
+  std::size_t queries = 0;  ///< Cached queries, see Registry::query()
+  std::size_t groups = 0;  ///< Owning groups
+  std::size_t bindings = 0;  ///< See Registry::register_binding()
+  std::size_t component_hooks = 0;  ///< See Registry::register_hook()
+  std::size_t global_hooks = 0;  ///< See Registry::register_global_hook()
+  std::vector<ComponentStats> components;  ///< Indexed by ComponentId
+
+  /**
+   * @brief Storage bytes of every component
+   */
+  std::size_t component_bytes() const
+  {
+    std::size_t total = 0;
+
+    for (auto const& comp : this->components) {
+      total += comp.storage_bytes;
+    }
+    return total;
+  }
+};
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include "ByteParser/ByteParser.hpp"
 #include "TwoWayMap.hpp"
@@ -36,6 +39,36 @@ enum class SceneState : std::uint8_t
   MAIN = 2  ///< Primary active scene, entities always processed
 };
 
+/**
+ * @brief Registry-local integer identifier of a scene
+ *
+ * Scene names are interned to a SceneId by the Registry (see
+ * Registry::intern_scene()), so per-entity scene filtering is an array lookup
+ * instead of a string hash.
+ */
+using SceneId = std::uint32_t;
+
+/**
+ * @brief SceneId of a Scene component not yet resolved by a Registry
+ */
+static constexpr SceneId NO_SCENE_ID = std::numeric_limits<SceneId>::max();
+
+/**
+ * @brief Bit mask of the levels a scene state satisfies
+ *
+ * Bit N is set when the state is at least SceneState(N), so checking a
+ * minimum level is a single shift. A scene that was never registered has an
+ * empty mask and matches no level.
+ *
+ * @param state The scene state
+ * @return Mask with bits 0..state set
+ */
+constexpr std::uint8_t scene_level_mask(SceneState state)
+{
+  return static_cast<std::uint8_t>(
+      (1U << (static_cast<std::uint8_t>(state) + 1U)) - 1U);
+}
+
 /**
  * @brief Bidirectional mapping between SceneState enum and string
  * representations
@@ -68,6 +101,10 @@ static const TwoWayMap<SceneState, std::string> SCENE_STATE_STR = {
  * @note Systems iterate only over entities in active scenes through the Zipper
  * pattern
  * @note Scene state lives in Registry::_scenes, not in this component
+ * @note id is filled by the Registry when the component is added, it is not
+ * serialized since ids are local to each Registry
+ * @note The name is allocator-aware: the Scene storage copies it into the
+ * Registry's memory resource, see SparseArray
  *
  * @see Registry::add_scene()
  * @see Registry::activate_scene()
@@ -75,17 +112,37 @@ static const TwoWayMap<SceneState, std::string> SCENE_STATE_STR = {
  */
 struct Scene
 {
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
   Scene() = default;
 
   /**
    * @brief Constructs a Scene component
    * @param scene_name Name identifier for the scene
+   * @param alloc Allocator of the name
    */
-  explicit Scene(std::string scene_name)
-      : scene_name(std::move(scene_name))
+  explicit Scene(std::string_view scene_name, allocator_type alloc = {})
+      : scene_name(scene_name, alloc)
+  {
+  }
+
+  Scene(Scene const& other, allocator_type alloc)
+      : scene_name(other.scene_name, alloc)
+      , id(other.id)
   {
   }
 
+  Scene(Scene&& other, allocator_type alloc)
+      : scene_name(std::move(other.scene_name), alloc)
+      , id(other.id)
+  {
+  }
+
+  Scene(Scene const&) = default;
+  Scene(Scene&&) = default;
+  Scene& operator=(Scene const&) = default;
+  Scene& operator=(Scene&&) = default;
+
   DEFAULT_BYTE_CONSTRUCTOR(
       Scene,
       ([](std::vector<char> name)
@@ -97,5 +154,6 @@ struct Scene
 
   HOOKABLE(Scene, HOOK(scene_name))
 
-  std::string scene_name;  ///< Identifier for this scene
+  std::pmr::string scene_name;  ///< Identifier for this scene
+  SceneId id = NO_SCENE_ID;  ///< Interned scene_name, set by the Registry
 };
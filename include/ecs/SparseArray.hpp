@@ -1,25 +1,69 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "ecs/ChangeTick.hpp"
+
 /**
- * @brief A sparse array implementation that stores components in an optional
- * vector.
+ * @brief A sparse set storing components in a packed (dense) array indexed
+ * through a paged sparse table.
+ *
+ * Layout:
+ * - _dense: packed components, only live values, in insertion order
+ * - _entities: entity id owning each dense slot (same order as _dense)
+ * - _pages: sparse table entity id -> dense index, split in fixed-size pages
+ *   allocated only when an entity of that range owns the component and freed
+ *   when the last one of the range loses it
+ *
+ * Iterating the array (begin()/end()) only walks live components. Random
+ * access by entity id (operator[]) costs two indirections and never
+ * allocates.
+ *
+ * The public API mirrors the former vector<optional<T>> storage: operator[]
+ * still returns an optional reference so plugins keep compiling. Looking up
+ * an entity that does not own the component returns an empty optional.
+ *
+ * The dense arrays (components, entity ids, ticks) and the sparse pages are
+ * allocated from the memory resource given at construction, the Registry
+ * passes its own pool so that pages freed and reallocated as waves spawn
+ * and die stay off the global allocator. Allocator-aware components (those
+ * declaring a std::pmr allocator_type, such as Scene) are copied into the
+ * same resource on insertion. Memory other components allocate themselves
+ * (a std::string, a JsonObject) still comes from the global allocator.
+ *
+ * Each live component also carries two change ticks: when it was added and
+ * when it was last written. insert_at() and modify() stamp them with the
+ * clock given to set_change_clock() (the Registry's change tick), Zipper
+ * filters such as Changed<T> compare them against a threshold.
+ *
+ * @warning erase() moves the last dense component into the erased slot,
+ * references to components of the same type may be invalidated by an erase
+ * or an insertion of a new entity.
  *
  * @tparam Component The type of component to be stored in the sparse array.
  */
 template<typename Component>
-class SparseArray : public std::vector<std::optional<Component>>
+class SparseArray
 {
 public:
   using Value =
       std::optional<Component>; /**< Type alias for the optional component value
                                    stored in the sparse array. */
   using Vtype =
-      std::vector<Value>; /**< Type alias for the underlying vector type. */
+      std::pmr::vector<Value>; /**< Type alias for the dense vector type. */
   using Ref = Value&; /**< Type alias for a reference to the optional component
                          value. */
   using Cref = Value const&; /**< Type alias for a const reference to the
@@ -30,23 +74,55 @@ public:
                                         the actual component value. */
   using SizeType = typename Vtype::size_type; /**< Type alias for the size type
                                                  of the underlying vector. */
-  using It = typename Vtype::iterator; /**< Type alias for an iterator to the
-                                          underlying vector. */
+  using It = typename Vtype::iterator; /**< Type alias for an iterator over the
+                                          dense components. */
   using Cit =
-      typename Vtype::const_iterator; /**< Type alias for a const iterator to
-                                         the underlying vector. */
+      typename Vtype::const_iterator; /**< Type alias for a const iterator over
+                                         the dense components. */
+
+  static constexpr SizeType page_size =
+      1024; /**< Number of entity ids covered by one sparse page. */
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+  SparseArray() = default;
 
   /**
-   * @brief Ensures the underlying vector has enough capacity and size to
-   * accommodate the given position.
+   * @brief Builds an empty array allocating from a memory resource.
+   *
+   * @param resource Resource of the dense arrays and the sparse pages, must
+   * outlive the array. Copies of the array use the default resource.
+   */
+  explicit SparseArray(std::pmr::memory_resource* resource)
+      : _dense(resource)
+      , _entities(resource)
+      , _added_ticks(resource)
+      , _changed_ticks(resource)
+      , _pages(resource)
+      , _page_counts(resource)
+  {
+  }
+
+  /**
+   * @brief Ensures the sparse table can address the given position.
+   *
+   * Allocates the sparse page covering pos if needed. Kept for compatibility
+   * with the former vector storage, insert_at() calls it implicitly.
    *
    * @param pos The position to reserve space for.
    */
   void reserve_init(SizeType pos)
   {
-    this->reserve(pos + 1);
-    while ((pos + 1) > this->size()) {
-      this->push_back({});
+    SizeType page = pos / page_size;
+
+    if (page >= this->_pages.size()) {
+      this->_pages.resize(page + 1);
+      this->_page_counts.resize(page + 1, 0);
+    }
+    if (this->_pages[page].empty()) {
+      this->_pages[page].assign(page_size, npos);
+    }
+    if (pos >= this->_extent) {
+      this->_extent = pos + 1;
     }
   }
 
@@ -59,9 +135,7 @@ public:
    */
   Ref insert_at(SizeType pos, Component&& v)
   {
-    this->reserve_init(pos);
-    (*this)[pos] = std::move(v);
-    return (*this)[pos];
+    return this->emplace_slot(pos, std::move(v));
   }
 
   /**
@@ -75,9 +149,8 @@ public:
   template<typename... Params>
   Ref insert_at(SizeType pos, Params&&... params)
   {
-    this->reserve_init(pos);
-    (*this)[pos] = Component(std::forward<Params>(params)...);
-    return (*this)[pos];
+    return this->emplace_slot(pos,
+                              Component(std::forward<Params>(params)...));
   }
 
   /**
@@ -89,38 +162,692 @@ public:
    */
   Ref insert_at(SizeType pos, Component const& v)
   {
-    this->reserve_init(pos);
-    (*this)[pos] = v;
-    return (*this)[pos];
+    return this->emplace_slot(pos, v);
+  }
+
+  /**
+   * @brief Reserves the dense arrays for count live components.
+   *
+   * @param count Number of components the array should hold without
+   * reallocating.
+   */
+  void reserve(SizeType count)
+  {
+    this->_dense.reserve(count);
+    this->_entities.reserve(count);
+    this->_added_ticks.reserve(count);
+    this->_changed_ticks.reserve(count);
+  }
+
+  /**
+   * @brief Inserts values[i] at positions[i] for every i.
+   *
+   * The dense arrays grow at most once for the whole batch and every
+   * component is stamped with the same tick. Components already present
+   * are replaced.
+   *
+   * @param positions Positions to insert at, as many as values.
+   * @param values The components to copy in.
+   */
+  void insert_range(std::span<SizeType const> positions,
+                    std::span<Component const> values)
+  {
+    ChangeTick tick = this->now();
+    SizeType needed = this->_dense.size() + positions.size();
+
+    // Geometric growth, many small batches stay amortized O(1) per insert
+    if (needed > this->_dense.capacity()) {
+      this->reserve(std::max(needed, 2 * this->_dense.capacity()));
+    }
+    for (SizeType i = 0; i < positions.size(); i++) {
+      SizeType pos = positions[i];
+      SizeType idx = this->dense_index(pos);
+
+      if (idx != npos) {
+        this->_dense[idx] = values[i];
+        this->_changed_ticks[idx] = tick;
+        continue;
+      }
+      this->reserve_init(pos);
+      this->sparse_slot(pos) = this->_dense.size();
+      this->_page_counts[pos / page_size] += 1;
+      this->_entities.push_back(pos);
+      this->_added_ticks.push_back(tick);
+      this->_changed_ticks.push_back(tick);
+      this->emplace_dense(values[i]);
+    }
   }
 
   /**
    * @brief  Erases the component at the specified position in the sparse array.
    *
+   * The last dense component is moved into the freed slot (swap and pop).
+   * The sparse page covering pos is released once it maps no entity.
+   *
    * @param pos The position of the component to erase.
    */
   void erase(SizeType pos)
   {
-    if (pos < this->size() && (*this)[pos].has_value()) {
-      (*this)[pos].reset();
+    SizeType idx = this->dense_index(pos);
+
+    if (idx == npos) {
+      return;
+    }
+    SizeType last = this->_dense.size() - 1;
+    if (idx != last) {
+      this->_dense[idx] = std::move(this->_dense[last]);
+      this->_entities[idx] = this->_entities[last];
+      this->_added_ticks[idx] = this->_added_ticks[last];
+      this->_changed_ticks[idx] = this->_changed_ticks[last];
+      this->sparse_slot(this->_entities[idx]) = idx;
+    }
+    this->_dense.pop_back();
+    this->_entities.pop_back();
+    this->_added_ticks.pop_back();
+    this->_changed_ticks.pop_back();
+    this->sparse_slot(pos) = npos;
+    this->release_page(pos / page_size);
+  }
+
+  /**
+   * @brief Swaps two dense slots, keeping the sparse table in sync.
+   *
+   * Lets the Registry keep the members of an owning group packed at the
+   * front of the dense arrays.
+   *
+   * @param a Dense index of the first component.
+   * @param b Dense index of the second component.
+   */
+  void swap_dense(SizeType a, SizeType b)
+  {
+    if (a == b) {
+      return;
+    }
+    std::swap(this->_dense[a], this->_dense[b]);
+    std::swap(this->_entities[a], this->_entities[b]);
+    std::swap(this->_added_ticks[a], this->_added_ticks[b]);
+    std::swap(this->_changed_ticks[a], this->_changed_ticks[b]);
+    this->sparse_slot(this->_entities[a]) = a;
+    this->sparse_slot(this->_entities[b]) = b;
+  }
+
+  /**
+   * @brief Write access by dense index, stamped as changed like modify().
+   */
+  TrueRef modify_dense(SizeType idx)
+  {
+    this->_changed_ticks[idx] = this->now();
+    return *this->_dense[idx];
+  }
+
+  /**
+   * @brief Returns unused capacity to the allocator.
+   *
+   * Shrinks the dense arrays to the live components and the sparse table to
+   * its last allocated page. size() may decrease.
+   */
+  void shrink_to_fit()
+  {
+    this->_dense.shrink_to_fit();
+    this->_entities.shrink_to_fit();
+    this->_added_ticks.shrink_to_fit();
+    this->_changed_ticks.shrink_to_fit();
+    while (!this->_pages.empty() && this->_pages.back().empty()) {
+      this->_pages.pop_back();
+      this->_page_counts.pop_back();
     }
+    this->_pages.shrink_to_fit();
+    this->_page_counts.shrink_to_fit();
+    this->_extent = std::min(this->_extent, this->_pages.size() * page_size);
+  }
+
+  /**
+   * @brief Number of sparse pages currently allocated.
+   */
+  SizeType allocated_pages() const
+  {
+    return static_cast<SizeType>(
+        std::ranges::count_if(this->_pages,
+                              [](auto const& page) { return !page.empty(); }));
   }
 
+  /**
+   * @brief Checks whether the entity at pos owns a component.
+   *
+   * @param pos The entity id to check.
+   * @return true if a component is stored for pos.
+   */
+  bool contains(SizeType pos) const { return this->dense_index(pos) != npos; }
+
+  /**
+   * @brief Returns the dense index of the component owned by pos.
+   *
+   * @param pos The entity id to look up.
+   * @return SizeType The index in the dense arrays, or npos if absent.
+   */
+  SizeType dense_index(SizeType pos) const
+  {
+    SizeType page = pos / page_size;
+
+    if (page >= this->_pages.size() || this->_pages[page].empty()) {
+      return npos;
+    }
+    return this->_pages[page][pos % page_size];
+  }
+
+  /**
+   * @brief Accesses the component owned by the entity at pos.
+   *
+   * @param pos The entity id.
+   * @return Ref The stored component, or an empty optional if absent.
+   */
+  Ref operator[](SizeType pos)
+  {
+    SizeType idx = this->dense_index(pos);
+
+    if (idx == npos) {
+      return missing();
+    }
+    return this->_dense[idx];
+  }
+
+  /**
+   * @copydoc operator[](SizeType)
+   */
+  Cref operator[](SizeType pos) const
+  {
+    SizeType idx = this->dense_index(pos);
+
+    if (idx == npos) {
+      return none();
+    }
+    return this->_dense[idx];
+  }
+
+  /**
+   * @brief Accesses the component owned by pos for writing.
+   *
+   * Same as operator[] but stamps the component as changed. Writes through
+   * operator[] or the iterators are not tracked.
+   *
+   * @param pos The entity id.
+   * @return Ref The stored component, or an empty optional if absent.
+   */
+  Ref modify(SizeType pos)
+  {
+    SizeType idx = this->dense_index(pos);
+
+    if (idx == npos) {
+      return missing();
+    }
+    this->_changed_ticks[idx] = this->now();
+    return this->_dense[idx];
+  }
+
+  /**
+   * @brief Stamps the component owned by pos as changed, if any.
+   */
+  void mark_changed(SizeType pos)
+  {
+    SizeType idx = this->dense_index(pos);
+
+    if (idx != npos) {
+      this->_changed_ticks[idx] = this->now();
+    }
+  }
+
+  /**
+   * @brief Change tick of the insertion of the component owned by pos.
+   * @return The tick, 0 if pos owns no component.
+   */
+  ChangeTick added_tick(SizeType pos) const
+  {
+    SizeType idx = this->dense_index(pos);
+
+    return idx == npos ? 0 : this->_added_ticks[idx];
+  }
+
+  /**
+   * @brief Change tick of the last tracked write of the component owned by
+   * pos (its insertion included).
+   * @return The tick, 0 if pos owns no component.
+   */
+  ChangeTick changed_tick(SizeType pos) const
+  {
+    SizeType idx = this->dense_index(pos);
+
+    return idx == npos ? 0 : this->_changed_ticks[idx];
+  }
+
+  /**
+   * @brief Sets the clock stamping insertions and tracked writes.
+   *
+   * @param clock Current change tick, read on every write. nullptr stamps
+   * everything with 0.
+   */
+  void set_change_clock(ChangeTick const* clock) { this->_clock = clock; }
+
+  /**
+   * @brief Bounds-checked access, mirrors std::vector::at.
+   *
+   * @param pos The entity id.
+   * @return Ref The stored component, or an empty optional if absent.
+   * @throws std::out_of_range if pos is past size().
+   */
+  Ref at(SizeType pos)
+  {
+    if (pos >= this->_extent) {
+      throw std::out_of_range("SparseArray::at");
+    }
+    return (*this)[pos];
+  }
+
+  /**
+   * @copydoc at(SizeType)
+   */
+  Cref at(SizeType pos) const
+  {
+    if (pos >= this->_extent) {
+      throw std::out_of_range("SparseArray::at");
+    }
+    return (*this)[pos];
+  }
+
+  /**
+   * @brief One past the highest entity id ever stored.
+   *
+   * Kept for the `e < array.size()` bound checks used across plugins, this is
+   * not the number of live components (see count()).
+   */
+  SizeType size() const { return this->_extent; }
+
+  /**
+   * @brief Number of live components.
+   */
+  SizeType count() const { return this->_dense.size(); }
+
+  /**
+   * @brief true when no entity owns this component.
+   */
+  bool empty() const { return this->_dense.empty(); }
+
+  /**
+   * @brief Number of components the dense array holds without growing.
+   */
+  SizeType capacity() const { return this->_dense.capacity(); }
+
+  /**
+   * @brief Bytes held by the storage itself: dense array, entity list,
+   * change ticks and allocated sparse pages.
+   *
+   * Memory owned by the components (strings, maps...) is not included.
+   */
+  SizeType memory_usage() const
+  {
+    SizeType bytes = (this->_dense.capacity() * sizeof(Value))
+        + (this->_entities.capacity() * sizeof(SizeType))
+        + ((this->_added_ticks.capacity() + this->_changed_ticks.capacity())
+           * sizeof(ChangeTick))
+        + (this->_pages.capacity() * sizeof(this->_pages[0]))
+        + (this->_page_counts.capacity() * sizeof(SizeType));
+
+    for (auto const& page : this->_pages) {
+      bytes += page.capacity() * sizeof(SizeType);
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Entity ids owning a component, in dense order.
+   */
+  std::pmr::vector<SizeType> const& entities() const
+  {
+    return this->_entities;
+  }
+
+  /**
+   * @brief Component stored at the given dense index.
+   */
+  Ref dense_at(SizeType idx) { return this->_dense[idx]; }
+
+  /**
+   * @copydoc dense_at(SizeType)
+   */
+  Cref dense_at(SizeType idx) const { return this->_dense[idx]; }
+
+  It begin() { return this->_dense.begin(); }
+
+  It end() { return this->_dense.end(); }
+
+  Cit begin() const { return this->_dense.begin(); }
+
+  Cit end() const { return this->_dense.end(); }
+
   /**
    * @brief   Finds the index of the specified component value in the sparse
    * array.
    *
    * @param val The component value to find.
-   * @return SizeType The index of the component value.
+   * @return SizeType The entity id owning the component value.
    * @throws std::out_of_range if the component value is not found.
    */
   SizeType get_index(Value const& val) const
   {
-    for (SizeType i = 0; i < this->size(); ++i) {
-      if ((*this)[i] == val) {
-        return i;
+    for (SizeType i = 0; i < this->_dense.size(); ++i) {
+      if (this->_dense[i] == val) {
+        return this->_entities[i];
       }
     }
     throw std::out_of_range("no matching value");
   }
+
+private:
+  static Cref none()
+  {
+    static const Value empty;
+    return empty;
+  }
+
+  /**
+   * @brief Writable empty optional returned on a miss
+   *
+   * One per thread, so workers probing missing entities concurrently never
+   * share it. Reset on every miss, writes through it are discarded.
+   */
+  static Ref missing()
+  {
+    thread_local Value empty;
+
+    empty.reset();
+    return empty;
+  }
+
+  SizeType& sparse_slot(SizeType pos)
+  {
+    return this->_pages[pos / page_size][pos % page_size];
+  }
+
+  /**
+   * @brief Drops one entity from a page and frees the page once unused.
+   */
+  void release_page(SizeType page)
+  {
+    this->_page_counts[page] -= 1;
+    if (this->_page_counts[page] == 0) {
+      this->_pages[page].clear();
+      this->_pages[page].shrink_to_fit();
+    }
+  }
+
+  template<typename V>
+  Ref emplace_slot(SizeType pos, V&& v)
+  {
+    SizeType idx = this->dense_index(pos);
+
+    if (idx != npos) {
+      this->_dense[idx] = std::forward<V>(v);
+      this->_changed_ticks[idx] = this->now();
+      return this->_dense[idx];
+    }
+    this->reserve_init(pos);
+    this->sparse_slot(pos) = this->_dense.size();
+    this->_page_counts[pos / page_size] += 1;
+    this->_entities.push_back(pos);
+    this->_added_ticks.push_back(this->now());
+    this->_changed_ticks.push_back(this->now());
+    return this->emplace_dense(std::forward<V>(v));
+  }
+
+  /**
+   * @brief Appends a dense slot, copying allocator-aware components into
+   * the array's memory resource.
+   *
+   * Replacing a live slot needs nothing: assignment keeps the allocator of
+   * the slot, and so does the move of a slot when the array grows.
+   */
+  template<typename V>
+  Ref emplace_dense(V&& v)
+  {
+    if constexpr (std::uses_allocator_v<Component,
+                                        std::pmr::polymorphic_allocator<>>)
+    {
+      return this->_dense.emplace_back(std::make_obj_using_allocator<Component>(
+          this->_dense.get_allocator(), std::forward<V>(v)));
+    } else {
+      return this->_dense.emplace_back(std::forward<V>(v));
+    }
+  }
+
+  ChangeTick now() const
+  {
+    return this->_clock == nullptr ? 0 : *this->_clock;
+  }
+
+  Vtype _dense;
+  std::pmr::vector<SizeType> _entities;
+  std::pmr::vector<ChangeTick> _added_ticks;  ///< Same order as _dense
+  std::pmr::vector<ChangeTick> _changed_ticks;  ///< Same order as _dense
+  std::pmr::vector<std::pmr::vector<SizeType>> _pages;
+  std::pmr::vector<SizeType> _page_counts;  ///< Entities mapped by each page
+  SizeType _extent = 0;
+  ChangeTick const* _clock = nullptr;
+};
+
+/**
+ * @brief Storage of a tag: a component type without data members.
+ *
+ * Tags only mark entities, so this specialization keeps one bit per entity
+ * id instead of a sparse set of values. The API matches SparseArray: every
+ * present entity yields the same engaged optional, insertions are accepted
+ * and their value discarded.
+ *
+ * Zipper never drives an iteration with a tag storage. A Zipper made only of
+ * tags ANDs their bit words and skips 64 entity ids per empty word.
+ *
+ * @note Tags have no change ticks, Changed<Tag> and Added<Tag> do not
+ * compile.
+ * @warning entities() is rebuilt lazily after changes and is not safe to
+ * call concurrently, it is meant for serialization.
+ *
+ * @tparam Component An empty component type.
+ */
+template<typename Component>
+  requires std::is_empty_v<Component>
+class SparseArray<Component>
+{
+public:
+  using Value = std::optional<Component>;
+  using Ref = Value&;
+  using Cref = Value const&;
+  using TrueRef = Component&;
+  using TrueCref = Component const&;
+  using SizeType = std::size_t;
+  using Word = std::uint64_t;
+
+  static constexpr SizeType word_bits = 64;
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+  SparseArray() = default;
+
+  /**
+   * @brief Same as the default constructor, a bitset does not allocate per
+   * entity so the resource is not used.
+   */
+  explicit SparseArray(std::pmr::memory_resource*) {}
+
+  /**
+   * @brief Grows the bitset so it can address pos.
+   */
+  void reserve_init(SizeType pos)
+  {
+    if (pos / word_bits >= this->_words.size()) {
+      this->_words.resize((pos / word_bits) + 1, 0);
+    }
+    if (pos >= this->_extent) {
+      this->_extent = pos + 1;
+    }
+  }
+
+  /**
+   * @brief Tags the entity at pos, the value itself is discarded.
+   */
+  template<typename... Params>
+  Ref insert_at(SizeType pos, Params&&... /*unused*/)
+  {
+    this->reserve_init(pos);
+    Word& word = this->_words[pos / word_bits];
+    Word bit = Word {1} << (pos % word_bits);
+
+    if ((word & bit) == 0) {
+      word |= bit;
+      this->_count += 1;
+      this->_entities_dirty = true;
+    }
+    return this->_present;
+  }
+
+  void reserve(SizeType /*unused*/) {}
+
+  /**
+   * @brief Tags every entity of positions, values are discarded.
+   */
+  void insert_range(std::span<SizeType const> positions,
+                    std::span<Component const> /*unused*/)
+  {
+    for (SizeType pos : positions) {
+      this->insert_at(pos);
+    }
+  }
+
+  /**
+   * @brief Removes the tag of the entity at pos, if any.
+   */
+  void erase(SizeType pos)
+  {
+    if (!this->contains(pos)) {
+      return;
+    }
+    this->_words[pos / word_bits] &= ~(Word {1} << (pos % word_bits));
+    this->_count -= 1;
+    this->_entities_dirty = true;
+  }
+
+  /**
+   * @brief Drops the trailing empty words, size() may decrease.
+   */
+  void shrink_to_fit()
+  {
+    while (!this->_words.empty() && this->_words.back() == 0) {
+      this->_words.pop_back();
+    }
+    this->_words.shrink_to_fit();
+    this->_entities.shrink_to_fit();
+    this->_extent = std::min(this->_extent, this->_words.size() * word_bits);
+  }
+
+  bool contains(SizeType pos) const
+  {
+    return pos / word_bits < this->_words.size()
+        && ((this->_words[pos / word_bits] >> (pos % word_bits)) & 1U) != 0;
+  }
+
+  Ref operator[](SizeType pos)
+  {
+    if (!this->contains(pos)) {
+      thread_local Value missing;
+
+      missing.reset();
+      return missing;
+    }
+    return this->_present;
+  }
+
+  Cref operator[](SizeType pos) const
+  {
+    static const Value none;
+
+    return this->contains(pos) ? this->_present : none;
+  }
+
+  Ref modify(SizeType pos) { return (*this)[pos]; }
+
+  void mark_changed(SizeType /*unused*/) {}
+
+  ChangeTick added_tick(SizeType /*unused*/) const { return 0; }
+
+  ChangeTick changed_tick(SizeType /*unused*/) const { return 0; }
+
+  void set_change_clock(ChangeTick const* /*unused*/) {}
+
+  Ref at(SizeType pos)
+  {
+    if (pos >= this->_extent) {
+      throw std::out_of_range("SparseArray::at");
+    }
+    return (*this)[pos];
+  }
+
+  Cref at(SizeType pos) const
+  {
+    if (pos >= this->_extent) {
+      throw std::out_of_range("SparseArray::at");
+    }
+    return (*this)[pos];
+  }
+
+  SizeType size() const { return this->_extent; }
+
+  SizeType count() const { return this->_count; }
+
+  bool empty() const { return this->_count == 0; }
+
+  /**
+   * @brief Number of entity ids the bitset addresses without growing.
+   */
+  SizeType capacity() const { return this->_words.capacity() * word_bits; }
+
+  /**
+   * @brief Bytes held by the bit words and the cached entity list.
+   */
+  SizeType memory_usage() const
+  {
+    return (this->_words.capacity() * sizeof(Word))
+        + (this->_entities.capacity() * sizeof(SizeType));
+  }
+
+  /**
+   * @brief Bit words, bit i of word w is entity (w * 64) + i.
+   */
+  std::vector<Word> const& words() const { return this->_words; }
+
+  /**
+   * @brief Tagged entity ids, ascending.
+   */
+  std::vector<SizeType> const& entities() const
+  {
+    if (this->_entities_dirty) {
+      this->_entities.clear();
+      this->_entities.reserve(this->_count);
+      for (SizeType w = 0; w < this->_words.size(); w++) {
+        for (Word bits = this->_words[w]; bits != 0; bits &= bits - 1) {
+          this->_entities.push_back(
+              (w * word_bits) + static_cast<SizeType>(std::countr_zero(bits)));
+        }
+      }
+      this->_entities_dirty = false;
+    }
+    return this->_entities;
+  }
+
+  Ref dense_at(SizeType /*unused*/) { return this->_present; }
+
+  Cref dense_at(SizeType /*unused*/) const { return this->_present; }
+
+private:
+  std::vector<Word> _words;
+  SizeType _count = 0;
+  SizeType _extent = 0;
+  Value _present = Component {};
+  mutable std::vector<SizeType> _entities;
+  mutable bool _entities_dirty = false;
 };
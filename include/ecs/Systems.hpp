@@ -1,13 +1,69 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <typeindex>
+#include <vector>
+
+#include "ecs/ChangeTick.hpp"
+#include "ecs/Scenes.hpp"
 
 /**
  * @file Systems.hpp
  * @brief System wrapper for ECS functionality
  */
 
+/**
+ * @brief Handle of a system registered in a Registry
+ *
+ * Returned by Registry::add_system() and Registry::add_concurrent_system(),
+ * used to enable, disable or remove the system later. Ids are never reused.
+ */
+using SystemId = std::size_t;
+
+/**
+ * @struct SystemAccess
+ * @brief Components a system declares to read and to write
+ *
+ * Used by Registry::run_systems() to find systems that can run at the same
+ * time. Two systems conflict when one writes a component the other reads or
+ * writes. An exclusive system conflicts with every other system: it may touch
+ * anything through the Registry (events, spawning, other components).
+ *
+ * @see Registry::add_concurrent_system()
+ */
+struct SystemAccess
+{
+  std::vector<std::type_index> reads;  ///< Components only read
+  std::vector<std::type_index> writes;  ///< Components read and written
+  bool exclusive = true;  ///< Conflicts with every other system
+
+  /**
+   * @brief Checks whether two systems must not run at the same time
+   * @param other Access declaration of the other system
+   * @return true if either is exclusive or one writes what the other uses
+   */
+  bool conflicts_with(SystemAccess const& other) const
+  {
+    if (this->exclusive || other.exclusive) {
+      return true;
+    }
+    auto touches = [](SystemAccess const& access, std::type_index const& type)
+    {
+      return std::ranges::find(access.reads, type) != access.reads.end()
+          || std::ranges::find(access.writes, type) != access.writes.end();
+    };
+    return std::ranges::any_of(this->writes,
+                               [&](auto const& type)
+                               { return touches(other, type); })
+        || std::ranges::any_of(other.writes,
+                               [&](auto const& type)
+                               { return touches(*this, type); });
+  }
+};
+
 /**
  * @class System
  * @brief Encapsulates a system function with priority-based execution ordering
@@ -57,9 +113,14 @@ public:
    * @brief Constructs a system with a function and priority
    * @param fn The system function to execute
    * @param priority Execution priority (higher values run first, default: 0)
+   * @param access Components the system reads and writes (default:
+   * exclusive)
    */
-  explicit System(std::function<void(Args...)> fn, std::size_t priority)
+  explicit System(std::function<void(Args...)> fn,
+                  std::size_t priority,
+                  SystemAccess access = {})
       : _priority(priority)
+      , _access(std::move(access))
       , _fn(std::move(fn))
   {
   }
@@ -86,7 +147,18 @@ public:
     return this->_priority > other._priority;
   }
 
+  /**
+   * @brief Components this system declared to read and write
+   */
+  SystemAccess const& access() const { return this->_access; }
+
   size_t _priority = 1;  ///< Execution priority (public for sorting access)
+  SystemId _id = 0;  ///< Handle given back by the Registry
+  bool _enabled = true;  ///< Disabled systems are not called
+  bool _removed = false;  ///< Erased at the start of the next frame
+  SceneId _scene = NO_SCENE_ID;  ///< Only runs while this scene is active
+  ChangeTick _last_run = 0;  ///< Change tick of its previous run, 0 if none
 private:
+  SystemAccess _access;  ///< Declared component access
   std::function<void(Args...)> _fn;  ///< The wrapped system function
 };
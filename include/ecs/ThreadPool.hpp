@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ThreadPool.hpp
+ * @brief Fixed-size worker pool used by the Registry to run systems in
+ * parallel
+ */
+
+/**
+ * @class ThreadPool
+ * @brief Runs indexed batches of tasks on a fixed set of worker threads
+ *
+ * The pool only knows one kind of job: call a task for every index in
+ * [0, count) and wait until they all returned. The calling thread takes part
+ * in the job, so a pool of N workers runs N + 1 tasks at once.
+ *
+ * @note Calling run() from inside a task runs the nested job inline on the
+ * current thread, it never deadlocks but does not add parallelism either.
+ * @note The first exception thrown by a task is rethrown by run() once every
+ * index has been processed.
+ *
+ * @code
+ * ThreadPool pool;
+ * std::vector<int> values(1000);
+ * pool.run(values.size(), [&values](std::size_t i) { values[i] = i * 2; });
+ * @endcode
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief Starts the worker threads
+   * @param workers Number of threads to spawn besides the caller
+   * (default: one less than the hardware concurrency)
+   */
+  explicit ThreadPool(std::size_t workers = default_workers());
+
+  /**
+   * @brief Stops and joins every worker thread
+   */
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  /**
+   * @brief Calls task(i) for every i in [0, count) and waits for all of them
+   * @param count Number of indices to process
+   * @param task Function called once per index, possibly concurrently
+   */
+  void run(std::size_t count, std::function<void(std::size_t)> const& task);
+
+  /**
+   * @brief Number of threads a job is split on, the caller included
+   */
+  std::size_t concurrency() const;
+
+  /**
+   * @brief Worker count used when none is given
+   */
+  static std::size_t default_workers();
+
+private:
+  void worker_loop();
+  void process_job();
+
+  std::vector<std::thread> _workers;
+  std::mutex _run_lock;  ///< Serializes jobs from different callers
+
+  std::mutex _lock;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  std::function<void(std::size_t)> const* _task = nullptr;
+  std::size_t _count = 0;
+  std::size_t _next = 0;
+  std::size_t _pending = 0;
+  std::size_t _generation = 0;
+  std::exception_ptr _error;
+  bool _stopping = false;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Zipper.hpp"
+#include "ecs/OwningGroup.hpp"
+#include "ecs/Registry.hpp"
+
+/**
+ * @class Group
+ * @brief Iterates the members of an owning group.
+ * @tparam Comps Component types of the group, const for read-only access.
+ *
+ * Obtained from Registry::group(). The members sit in the first
+ * OwningGroup::size() dense slots of every owned storage, in the same order,
+ * so slot i of each storage is fetched directly: no sparse lookup and no
+ * membership test.
+ *
+ * @note Entities are filtered by scene exactly like Zipper does.
+ * @note Non-const Comps are stamped as changed when visited, like Zipper.
+ * @warning Do not remove components of the group during each() or
+ * par_each(), the erase moves members inside the storages. Record such
+ * changes in Registry::commands() instead. Entities completing the group
+ * during the loop join it once the loop ends.
+ *
+ * @code
+ * r.group<Position, Direction const, Speed const>().par_each(
+ *   [dt](Ecs::Entity, Position& pos, Direction const& dir, Speed const& spd)
+ *   { pos.pos += dir.direction * spd.speed * dt; });
+ * @endcode
+ *
+ * @see OwningGroup
+ */
+template<class... Comps>
+class Group
+{
+  static_assert((!std::is_empty_v<std::remove_const_t<Comps>> && ...),
+                "tags are not stored densely and cannot be grouped");
+
+public:
+  /**
+   * @brief Prepares an iteration over a group of the Registry.
+   * @param r Registry owning the group, the storages and the scene data
+   * @param group Group owning exactly the Comps
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   */
+  Group(Registry& r,
+        OwningGroup const& group,
+        SceneState min_scene_level = SceneState::ACTIVE)
+      : _registry(r)
+      , _loop(r)
+      , _group(group)
+      , _storages(&r.get_components<std::remove_const_t<Comps>>()...)
+      , _scenes(r.get_components<Scene>())
+      , _scene_masks(r.get_scene_masks())
+      , _min_scene_level(min_scene_level)
+  {
+  }
+
+  /**
+   * @brief Calls fn(entity, comps...) for every member.
+   * @tparam Function Callable type (deduced)
+   * @param fn The function to call
+   */
+  template<class Function>
+  void each(Function&& fn)
+  {
+    this->visit(fn, 0, this->_group.size());
+  }
+
+  /**
+   * @brief Calls fn(entity, comps...) for every member, on the worker pool.
+   *
+   * Members are split in contiguous chunks like ZipperIndex::par_each(),
+   * the same rules apply to fn.
+   *
+   * @tparam Function Callable type (deduced)
+   * @param fn The function to call, possibly concurrently
+   */
+  template<class Function>
+  void par_each(Function&& fn)
+  {
+    std::size_t total = this->_group.size();
+    std::size_t chunk = zipper_chunk_size<Comps...>();
+
+    this->_registry.run_parallel(
+        (total + chunk - 1) / chunk,
+        [this, &fn, total, chunk](std::size_t c)
+        { this->visit(fn, c * chunk, std::min(total, (c + 1) * chunk)); });
+  }
+
+  /**
+   * @brief Number of members, scenes not considered.
+   */
+  std::size_t size() const { return this->_group.size(); }
+
+private:
+  template<class Function>
+  void visit(Function& fn, std::size_t first, std::size_t last)
+  {
+    bool filter_scenes = !this->_scenes.empty();
+    std::pmr::vector<std::size_t> const& entities =
+        std::get<0>(this->_storages)->entities();
+
+    for (std::size_t i = first; i < last; i++) {
+      Ecs::Entity e = entities[i];
+
+      if (filter_scenes
+          && !scene_allows(
+              this->_scenes, this->_scene_masks, e, this->_min_scene_level))
+      {
+        continue;
+      }
+      std::apply([&fn, e, i](auto*... storage)
+                 { fn(e, fetch(*storage, i)...); },
+                 this->_storages);
+    }
+  }
+
+  template<class Component>
+  static Component const& fetch(SparseArray<Component> const& storage,
+                                std::size_t i)
+  {
+    return *storage.dense_at(i);
+  }
+
+  template<class Component>
+  static Component& fetch(SparseArray<Component>& storage, std::size_t i)
+  {
+    return storage.modify_dense(i);
+  }
+
+  /**
+   * @brief Storage of a Comp, const-qualified for const Comps.
+   */
+  template<class Comp>
+  using Storage =
+      std::conditional_t<std::is_const_v<Comp>,
+                         SparseArray<std::remove_const_t<Comp>> const,
+                         SparseArray<Comp>>;
+
+  Registry& _registry;  ///< Provides the worker pool of par_each().
+  Registry::LoopScope _loop;  ///< Holds owning group moves back
+  OwningGroup const& _group;
+  std::tuple<Storage<Comps>*...> _storages;
+  SparseArray<Scene> const& _scenes;
+  std::vector<std::uint8_t> const& _scene_masks;  ///< Level mask per SceneId
+  SceneState _min_scene_level;  ///< Minimum scene state level to include
+};
+
+template<class... Comps>
+Group<Comps...> Registry::group(SceneState min_scene_level)
+{
+  return Group<Comps...>(
+      *this,
+      this->owning_group(
+          {this->component_id<std::remove_const_t<Comps>>()...}),
+      min_scene_level);
+}
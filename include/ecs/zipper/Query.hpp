@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Zipper.hpp"
+#include "ecs/QueryCache.hpp"
+#include "ecs/Registry.hpp"
+
+/**
+ * @class Query
+ * @brief Iterates the members of a persistent QueryCache.
+ * @tparam Comps Component types to fetch, const for read-only access.
+ *
+ * Obtained from Registry::query(). Unlike Zipper, which probes every Comp
+ * for each entity of the smallest storage, the matching entities are kept
+ * by the Registry and updated when components are added or removed, so each
+ * visited entity is a match.
+ *
+ * @note Entities are filtered by scene exactly like Zipper does.
+ * @note Non-const Comps are stamped as changed when visited, like Zipper.
+ * @note Members are visited in no particular order. Removing a component of
+ * the current entity during each() skips the entity moved into its slot,
+ * entities gaining the components during the loop are visited.
+ *
+ * @code
+ * r.query<Position, Speed const>().each(
+ *   [dt](Ecs::Entity, Position& pos, Speed const& speed)
+ *   { pos.pos += speed.speed * dt; });
+ * @endcode
+ *
+ * @see QueryCache
+ */
+template<class... Comps>
+class Query
+{
+public:
+  /**
+   * @brief Prepares an iteration over a cache of the Registry.
+   * @param r Registry owning the cache, the storages and the scene data
+   * @param cache Members to visit, must require every Comp
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   */
+  Query(Registry& r,
+        QueryCache const& cache,
+        SceneState min_scene_level = SceneState::ACTIVE)
+      : _cache(cache)
+      , _storages(&r.get_components<std::remove_const_t<Comps>>()...)
+      , _scenes(r.get_components<Scene>())
+      , _scene_masks(r.get_scene_masks())
+      , _min_scene_level(min_scene_level)
+  {
+  }
+
+  /**
+   * @brief Calls fn(entity, comps...) for every member.
+   * @tparam Function Callable type (deduced)
+   * @param fn The function to call
+   */
+  template<class Function>
+  void each(Function&& fn)
+  {
+    bool filter_scenes = !this->_scenes.empty();
+    std::vector<Ecs::Entity> const& entities = this->_cache.entities();
+
+    for (std::size_t i = 0; i < entities.size(); i++) {
+      Ecs::Entity e = entities[i];
+
+      if (filter_scenes
+          && !scene_allows(
+              this->_scenes, this->_scene_masks, e, this->_min_scene_level))
+      {
+        continue;
+      }
+      std::apply([&fn, e](auto*... storage)
+                 { fn(e, fetch(*storage, e)...); },
+                 this->_storages);
+    }
+  }
+
+  /**
+   * @brief Number of members, scenes not considered.
+   */
+  std::size_t count() const { return this->_cache.entities().size(); }
+
+  /**
+   * @brief Members of the query, scenes not considered.
+   */
+  std::vector<Ecs::Entity> const& entities() const
+  {
+    return this->_cache.entities();
+  }
+
+private:
+  template<class Component>
+  static Component const& fetch(SparseArray<Component> const& storage,
+                                Ecs::Entity e)
+  {
+    return *storage[e];
+  }
+
+  template<class Component>
+  static Component& fetch(SparseArray<Component>& storage, Ecs::Entity e)
+  {
+    return *storage.modify(e);
+  }
+
+  /**
+   * @brief Storage of a Comp, const-qualified for const Comps.
+   */
+  template<class Comp>
+  using Storage =
+      std::conditional_t<std::is_const_v<Comp>,
+                         SparseArray<std::remove_const_t<Comp>> const,
+                         SparseArray<Comp>>;
+
+  QueryCache const& _cache;
+  std::tuple<Storage<Comps>*...> _storages;
+  SparseArray<Scene> const& _scenes;
+  std::vector<std::uint8_t> const& _scene_masks;  ///< Level mask per SceneId
+  SceneState _min_scene_level;  ///< Minimum scene state level to include
+};
+
+template<class... Comps>
+Query<Comps...> Registry::query(SceneState min_scene_level)
+{
+  return Query<Comps...>(
+      *this,
+      this->query_cache(
+          {this->component_id<std::remove_const_t<Comps>>()...}),
+      min_scene_level);
+}
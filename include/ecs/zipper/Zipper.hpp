@@ -1,7 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -14,6 +19,146 @@
 template<class... Comps>
 class ZipperIndexIterator;
 
+/**
+ * @brief Zipper filter: only yields entities whose Comp was written since the
+ * zipper's change threshold.
+ * @tparam Comp The component type, const for read-only access.
+ *
+ * Yields Comp exactly like an unfiltered Comp would.
+ *
+ * @code
+ * // Only the sprites of entities that moved since this system last ran
+ * for (auto&& [pos, sprite] : Zipper<Changed<Position const>, Sprite>(r)) {
+ *   sprite.move_to(pos.pos);
+ * }
+ * @endcode
+ *
+ * @see Registry::change_tick()
+ */
+template<class Comp>
+struct Changed
+{
+};
+
+/**
+ * @brief Zipper filter: only yields entities whose Comp was inserted since
+ * the zipper's change threshold.
+ * @tparam Comp The component type, const for read-only access.
+ * @see Changed
+ */
+template<class Comp>
+struct Added
+{
+};
+
+/**
+ * @brief Describes how a Zipper parameter is fetched and filtered.
+ * @tparam Comp A component type, possibly const, or a filter wrapping one.
+ */
+template<class Comp>
+struct ZipperParam
+{
+  using Type = Comp;  ///< Yielded component type, const for read access
+
+  template<class Storage>
+  static bool accepts(Storage const& /*unused*/,
+                      std::size_t /*unused*/,
+                      ChangeTick /*unused*/)
+  {
+    return true;
+  }
+};
+
+template<class Comp>
+struct ZipperParam<Changed<Comp>>
+{
+  static_assert(!std::is_empty_v<std::remove_const_t<Comp>>,
+                "tag components have no change ticks");
+
+  using Type = Comp;
+
+  template<class Storage>
+  static bool accepts(Storage const& storage, std::size_t e, ChangeTick since)
+  {
+    return storage.changed_tick(e) >= since;
+  }
+};
+
+template<class Comp>
+struct ZipperParam<Added<Comp>>
+{
+  static_assert(!std::is_empty_v<std::remove_const_t<Comp>>,
+                "tag components have no change ticks");
+
+  using Type = Comp;
+
+  template<class Storage>
+  static bool accepts(Storage const& storage, std::size_t e, ChangeTick since)
+  {
+    return storage.added_tick(e) >= since;
+  }
+};
+
+/**
+ * @brief Component type of a Zipper parameter, filters unwrapped.
+ */
+template<class Comp>
+using zipper_component_t = typename ZipperParam<Comp>::Type;
+
+/**
+ * @brief true for the bitset storage of a tag (see SparseArray).
+ */
+template<class Storage>
+constexpr bool is_tag_storage_v = false;
+
+template<class Component>
+constexpr bool is_tag_storage_v<SparseArray<Component>> =
+    std::is_empty_v<Component>;
+
+template<class Component>
+constexpr bool is_tag_storage_v<SparseArray<Component> const> =
+    std::is_empty_v<Component>;
+
+/**
+ * @brief true when a zipper over these storages is made only of tags.
+ */
+template<class... Storages>
+constexpr bool zipper_only_tags_v =
+    sizeof...(Storages) > 0 && (is_tag_storage_v<Storages> && ...);
+
+/**
+ * @brief Checks whether an entity's scene passes a Zipper scene filter.
+ * @param scenes Scene component sparse array
+ * @param scene_masks Level mask of every interned scene, indexed by SceneId
+ * @param entity The entity to check
+ * @param min_scene_level Minimum scene state level to include
+ * @return true if the entity has no scene or its scene is at least
+ * min_scene_level
+ */
+inline bool scene_allows(SparseArray<Scene> const& scenes,
+                         std::vector<std::uint8_t> const& scene_masks,
+                         std::size_t entity,
+                         SceneState min_scene_level)
+{
+  auto const& scene = scenes[entity];
+
+  // Entity has no scene component, include it by default
+  if (!scene.has_value()) {
+    return true;
+  }
+
+  // Unresolved or unknown scene, skip this entity
+  if (scene->id >= scene_masks.size()) {
+    return false;
+  }
+
+  // Bit N of the mask is set when the scene state is at least N, a scene
+  // that was interned but never registered has no bit set
+  return ((scene_masks[scene->id] >> static_cast<std::uint8_t>(min_scene_level))
+          & 1U)
+      != 0;
+}
+
 /**
  * @class ZipperIterator
  * @brief Iterator that simultaneously traverses multiple Comps and yields
@@ -22,14 +167,22 @@ class ZipperIndexIterator;
  * iterate over.
  *
  * This iterator implements a zipper pattern that combines multiple Comps
- * into a single iteration stream. It only yields values where all Comps
- * have valid (non-empty optional) values at the current position. The iterator
- * automatically skips positions where any Comp lacks a value.
+ * into a single iteration stream. It walks the packed entity list of one Comp
+ * (the driver, chosen by the owning range as the Comp with the fewest live
+ * components) and probes the other Comps for each of those entities. It only
+ * yields entities for which every Comp holds a value.
  *
- * @note The iterator uses const iterators (Cit) for const Comps and
- * regular iterators (It) for non-const Comps.
- * @note Iteration stops at the size of the smallest Comp to prevent
- * out-of-bounds access.
+ * @note Const Comps are accessed through a const SparseArray. Non-const
+ * Comps are stamped as changed (SparseArray::modify()) when dereferenced,
+ * ask for const access to leave Changed<> filters untouched.
+ * @note Changed<Comp> and Added<Comp> filter on the change ticks of Comp.
+ * @note Iteration cost scales with the size of the smallest Comp, not with
+ * the highest entity id.
+ * @note Entities are visited in the driver's packed order, not by ascending
+ * id. Components added to the driver during the loop are visited, removing
+ * the current entity's driver component skips the entity moved into its slot.
+ * Changes to other storages never reorder the driver: owning groups are not
+ * sorted while a Zipper is alive, see Registry::LoopScope.
  *
  * @code
  * SparseArray<int> arr1;
@@ -47,25 +200,15 @@ public:
   friend class ZipperIndexIterator<Comps...>;
 
   /**
-   * @typedef Iterator
-   * @brief Selects appropriate iterator type based on Comp constness.
-   * @tparam Comp The Comp type to get an iterator for.
-   *
-   * For const Comps, uses Comp::Cit (const iterator).
-   * For non-const Comps, uses Comp::It (regular iterator).
-   */
-  template<class Comp>
-  using Iterator = std::conditional_t<std::is_const_v<Comp>,
-                                      typename SparseArray<Comp>::Cit,
-                                      typename SparseArray<Comp>::It>;
-
-  /**
-   * @typedef ItRef
-   * @brief Reference type returned by the iterator.
+   * @typedef Storage
+   * @brief Storage type of a Comp, const-qualified for const Comps.
    * @tparam Comp The Comp type.
    */
   template<class Comp>
-  using ItRef = typename Iterator<Comp>::reference;
+  using Storage = std::conditional_t<
+      std::is_const_v<zipper_component_t<Comp>>,
+      SparseArray<std::remove_const_t<zipper_component_t<Comp>>> const,
+      SparseArray<zipper_component_t<Comp>>>;
 
   /**
    * @typedef Value
@@ -77,9 +220,9 @@ public:
    * For non-const Comps, uses Comp::TrueRef (reference to value).
    */
   template<class Comp>
-  using Value = std::conditional_t<std::is_const_v<Comp>,
-                                   typename SparseArray<Comp>::TrueCref,
-                                   typename SparseArray<Comp>::TrueRef>;
+  using Value = std::conditional_t<std::is_const_v<zipper_component_t<Comp>>,
+                                   typename Storage<Comp>::TrueCref,
+                                   typename Storage<Comp>::TrueRef>;
 
   /** @brief Tuple type containing values from all Comps. */
   using ValueType = std::tuple<Value<Comps>...>;
@@ -93,51 +236,44 @@ public:
   /** @brief Difference type for iterator arithmetic. */
   using DifferenceType = std::size_t;
 
-  /** @brief Tuple type containing iterators for all Comps. */
-  using IteratorTuple = std::tuple<Iterator<Comps>...>;
-
-  /** @brief Alias for IteratorTuple for backward compatibility. */
-  using iterator_tuple = IteratorTuple;
+  /** @brief Tuple type containing the storage of every Comp. */
+  using StorageTuple = std::tuple<Storage<Comps>*...>;
 
   /** @brief Compile-time index sequence for parameter pack expansion. */
   static constexpr std::index_sequence_for<Comps...> seq {};
 
   /**
-   * @brief Constructs a zipper iterator from a tuple of Comp iterators.
-   * @param it_tuple Tuple containing iterators for each Comp.
+   * @brief Constructs a zipper iterator over the storages of the Comps.
+   * @param storages Tuple containing the storage of each Comp.
+   * @param driver Packed entity list of the smallest Comp, walked in order.
    * @param scene_array Scene component sparse array
-   * @param active_scenes Set of currently active scene names
-   * @param scene_states Map of scene names to their state levels
-   * @param max Maximum number of elements to iterate over (size of smallest
-   * Comp).
-   * @param index Starting index position (default: 0).
+   * @param scene_masks Level mask of every interned scene, indexed by
+   * SceneId
+   * @param pos Starting position in the driver list (npos for end()).
    * @param min_scene_level Minimum scene state level to include (default:
    * ACTIVE)
+   * @param since Oldest change tick accepted by Changed and Added filters
    *
    * The constructor advances to the first position where all Comps have
-   * valid values. Positions with empty optionals in any Comp are
-   * automatically skipped.
+   * valid values. Entities missing in any Comp are automatically skipped.
    */
   ZipperIterator(
-      IteratorTuple const& it_tuple,
+      StorageTuple const& storages,
+      std::pmr::vector<std::size_t> const* driver,
       SparseArray<Scene>& scene_array,
-      std::unordered_set<std::string> const& active_scenes,
-      std::unordered_map<std::string, SceneState> const& scene_states,
-      std::size_t max,
-      std::size_t index = 0,
-      SceneState min_scene_level = SceneState::ACTIVE)
-      : _current(it_tuple)
-      , _max(max)
-      , _scene(scene_array.begin())
-      , _scene_size(scene_array.size())
-      , _active_scenes(active_scenes)
-      , _scene_states(scene_states)
+      std::vector<std::uint8_t> const& scene_masks,
+      std::size_t pos = 0,
+      SceneState min_scene_level = SceneState::ACTIVE,
+      ChangeTick since = 0)
+      : _storages(storages)
+      , _driver(driver)
+      , _pos(pos)
+      , _scene(scene_array)
+      , _scene_masks(scene_masks)
       , _min_scene_level(min_scene_level)
-      , _idx(index)
+      , _since(since)
   {
-    while (this->_idx < this->_max && !this->all_set(seq)) {
-      this->incr_all(seq);
-    }
+    this->settle();
   }
 
   /**
@@ -145,13 +281,13 @@ public:
    * @param z The zipper iterator to copy from.
    */
   ZipperIterator(ZipperIterator const& z)
-      : _current(z._current)
-      , _max(z._max)
+      : _storages(z._storages)
+      , _driver(z._driver)
+      , _pos(z._pos)
       , _scene(z._scene)
-      , _scene_size(z._scene_size)
-      , _active_scenes(z._active_scenes)
-      , _scene_states(z._scene_states)
+      , _scene_masks(z._scene_masks)
       , _min_scene_level(z._min_scene_level)
+      , _since(z._since)
       , _idx(z._idx)
   {
   }
@@ -160,15 +296,13 @@ public:
    * @brief Pre-increment operator. Advances to the next valid position.
    * @return Reference to this iterator after incrementing.
    *
-   * Advances all underlying iterators and skips positions where any Comp
-   * has an empty optional value. Continues until finding a position where all
-   * Comps have valid values or reaching the end.
+   * Moves to the next entity of the driver list, skipping entities missing a
+   * Comp or filtered out by their scene.
    */
   ZipperIterator& operator++()
   {
-    do {
-      this->incr_all(seq);
-    } while (this->_idx < this->_max && !this->all_set(seq));
+    this->_pos += 1;
+    this->settle();
     return *this;
   }
 
@@ -199,10 +333,16 @@ public:
   /**
    * @brief Equality comparison operator.
    * @param rhs The iterator to compare with.
-   * @return true if both iterators are at the same index position, false
-   * otherwise.
+   * @return true if both iterators are exhausted or at the same driver
+   * position, false otherwise.
    */
-  bool operator==(ZipperIterator const& rhs) { return this->_idx == rhs._idx; }
+  bool operator==(ZipperIterator const& rhs)
+  {
+    if (this->at_end() || rhs.at_end()) {
+      return this->at_end() && rhs.at_end();
+    }
+    return this->_pos == rhs._pos;
+  }
 
   /**
    * @brief Inequality comparison operator.
@@ -212,67 +352,66 @@ public:
    */
   bool operator!=(ZipperIterator const& rhs) { return !(*this == rhs); }
 
+  /**
+   * @brief Current position in the driver list.
+   * @return The position, at least the driver size once exhausted.
+   */
+  std::size_t position() const
+  {
+    return this->at_end() ? SparseArray<Scene>::npos : this->_pos;
+  }
+
 private:
   /**
-   * @brief Increments all underlying iterators simultaneously.
-   * @tparam Is Index sequence for parameter pack expansion.
+   * @brief true once the driver list is exhausted.
    *
-   * Increments the internal index and advances each iterator in the tuple.
+   * Compared against the live size so components erased from the driver
+   * during the loop never make the iterator read past the list.
    */
-  template<std::size_t... Is>
-  void incr_all(std::index_sequence<Is...> /*unused*/)
+  bool at_end() const
   {
-    if (this->_idx < this->_scene_size) {
-      this->_scene++;
+    return this->_driver == nullptr || this->_pos >= this->_driver->size();
+  }
+
+  /**
+   * @brief Advances until the current driver entity matches every Comp.
+   */
+  void settle()
+  {
+    while (!this->at_end()) {
+      this->_idx = (*this->_driver)[this->_pos];
+      if (this->all_set(seq)) {
+        return;
+      }
+      this->_pos += 1;
     }
-    this->_idx += 1;
-    (std::get<Is>(this->_current)++, ...);
   }
 
   /**
    * @brief Checks if all Comps have valid values at the current position.
    * @tparam Is Index sequence for parameter pack expansion.
-   * @return true if all iterators point to valid (non-empty optional) values
-   * and the entity's scene meets the minimum level requirement, false
-   * otherwise.
+   * @return true if all storages hold a value for the current entity that
+   * passes its Comp filter and the entity's scene meets the minimum level
+   * requirement, false otherwise.
    */
   template<std::size_t... Is>
   bool all_set(std::index_sequence<Is...> /*unused*/) const
   {
-    // Check if entity is in a scene with sufficient level
-    // Only check scene if we're within the scene array bounds
-    if (this->_idx < this->_scene_size) {
-      // Ensure the scene iterator points to a valid optional before
-      // dereferencing
-      if (this->_scene->has_value()) {
-        const auto& scene_name = this->_scene->value().scene_name;
-
-        // Look up the scene state
-        auto it = this->_scene_states.find(scene_name);
-        if (it != this->_scene_states.end()) {
-          // Check if scene state meets minimum level requirement
-          // Using the numeric values: DISABLED=0, ACTIVE=1, MAIN=2
-          if (static_cast<std::uint8_t>(it->second)
-              >= static_cast<std::uint8_t>(this->_min_scene_level))
-          {
-            // Scene meets minimum level, check if all components are set
-            return ((*(std::get<Is>(this->_current))).has_value() && ...);
-          }
-          // Scene level is too low, skip this entity
-          return false;
-        }
-
-        // Scene not found in states map, skip this entity
-        return false;
-      }
+    if (!(std::get<Is>(this->_storages)->contains(this->_idx) && ...)) {
+      return false;
     }
-
-    // Entity has no scene component, include it by default
-    return ((*(std::get<Is>(this->_current))).has_value() && ...);
+    if (!(ZipperParam<Comps>::accepts(
+              *std::get<Is>(this->_storages), this->_idx, this->_since)
+          && ...))
+    {
+      return false;
+    }
+    return scene_allows(
+        this->_scene, this->_scene_masks, this->_idx, this->_min_scene_level);
   }
 
   /**
-   * @brief Extracts values from all iterators and returns them as a tuple.
+   * @brief Extracts values from all storages and returns them as a tuple.
    * @tparam Is Index sequence for parameter pack expansion.
    * @return Tuple containing references to the actual values (unwrapped from
    * optionals).
@@ -280,22 +419,120 @@ private:
   template<std::size_t... Is>
   ValueType to_value(std::index_sequence<Is...> /*unused*/)
   {
-    return std::forward_as_tuple(std::get<Is>(this->_current)->value()...);
+    return std::forward_as_tuple(
+        this->fetch<Comps>(std::get<Is>(this->_storages))...);
   }
 
-  IteratorTuple
-      _current;  ///< Tuple of current iterator positions for each Comp.
-  std::size_t _max;  ///< Maximum iteration count (size of smallest Comp).
-  Iterator<Scene> _scene;
-  std::size_t _scene_size;
-  std::unordered_set<std::string> const& _active_scenes;
-  std::unordered_map<std::string, SceneState> const& _scene_states;
+  /**
+   * @brief Value of one Comp for the current entity, stamped as changed
+   * unless accessed through a const storage.
+   */
+  template<class Comp>
+  Value<Comp> fetch(Storage<Comp>* storage)
+  {
+    if constexpr (std::is_const_v<Storage<Comp>>) {
+      return (*storage)[this->_idx].value();
+    } else {
+      return storage->modify(this->_idx).value();
+    }
+  }
+
+  StorageTuple _storages;  ///< Storage of each Comp.
+  std::pmr::vector<std::size_t> const*
+      _driver;  ///< Packed entity list of the smallest Comp.
+  std::size_t _pos;  ///< Current position in the driver list.
+  SparseArray<Scene> const& _scene;
+  std::vector<std::uint8_t> const& _scene_masks;  ///< Level mask per SceneId
   SceneState _min_scene_level;  ///< Minimum scene state level to include
+  ChangeTick _since;  ///< Oldest change tick accepted by filters
 
 protected:
-  std::size_t _idx;  ///< Current index position in the iteration.
+  std::size_t _idx = 0;  ///< Entity id at the current position.
 };
 
+/**
+ * @brief Picks the packed entity list of the storage holding the fewest live
+ * components.
+ * @param storages Tuple of Comp storages.
+ * @return Entity list to drive a zipper with, nullptr if there is no Comp
+ * or only tags.
+ *
+ * Tag storages never drive, they are only probed.
+ */
+template<class... Storages>
+std::pmr::vector<std::size_t> const* zipper_driver(
+    std::tuple<Storages*...> const& storages)
+{
+  std::pmr::vector<std::size_t> const* driver = nullptr;
+  auto consider = [&driver](auto* storage)
+  {
+    if constexpr (!is_tag_storage_v<std::remove_pointer_t<decltype(storage)>>)
+    {
+      if (driver == nullptr || storage->count() < driver->size()) {
+        driver = &storage->entities();
+      }
+    }
+  };
+
+  std::apply([&consider](auto*... storage) { (consider(storage), ...); },
+             storages);
+  return driver;
+}
+
+/**
+ * @brief Entities owning every tag, found by ANDing the tag bit words.
+ * @param storages Tuple of tag storages.
+ * @return Matching entity ids, ascending, empty words skip 64 ids at once.
+ * nullptr when a storage is not a tag storage.
+ */
+template<class... Storages>
+std::shared_ptr<std::pmr::vector<std::size_t> const> zipper_tag_matches(
+    std::tuple<Storages*...> const& storages)
+{
+  if constexpr (!zipper_only_tags_v<Storages...>) {
+    return nullptr;
+  } else {
+    auto matches = std::make_shared<std::pmr::vector<std::size_t>>();
+
+    std::size_t words = std::apply(
+        [](auto*... storage)
+        { return std::min({storage->words().size()...}); },
+        storages);
+
+    for (std::size_t w = 0; w < words; w++) {
+      std::uint64_t bits = std::apply(
+          [w](auto*... storage) { return (storage->words()[w] & ...); },
+          storages);
+
+      for (; bits != 0; bits &= bits - 1) {
+        matches->push_back((w * 64)
+                           + static_cast<std::size_t>(std::countr_zero(bits)));
+      }
+    }
+    return matches;
+  }
+}
+
+/**
+ * @brief Number of driver entries handed to a worker at once by par_each().
+ *
+ * Sized so that the components of one chunk fit in a 32 KiB L1 data cache,
+ * with a floor so small components do not produce tiny jobs.
+ *
+ * @tparam Comps Comp types of the loop.
+ */
+template<class... Comps>
+constexpr std::size_t zipper_chunk_size()
+{
+  constexpr std::size_t cache_bytes = 32 * 1024;
+  constexpr std::size_t min_chunk = 64;
+  constexpr std::size_t entry_bytes = sizeof(std::size_t)
+      + (sizeof(std::optional<std::remove_const_t<zipper_component_t<Comps>>>)
+         + ... + 0);
+
+  return std::max(min_chunk, cache_bytes / entry_bytes);
+}
+
 /**
  * @class Zipper
  * @brief Range adapter that simultaneously iterates over multiple Comps.
@@ -305,11 +542,11 @@ protected:
  * This class provides a convenient interface for parallel iteration over
  * multiple Comps. It returns a ZipperIterator that yields tuples of values
  * from each Comp where all Comps have valid (non-empty optional)
- * values at the same position.
+ * values for the same entity.
  *
- * @note The zipper respects the size of the smallest Comp to prevent
- * out-of-bounds access.
- * @note Only positions where all Comps have valid values are yielded
+ * @note The Comp with the fewest live components drives the iteration, the
+ * other Comps are only probed for the driver's entities.
+ * @note Only entities where all Comps have valid values are yielded
  * during iteration.
  *
  * @code
@@ -329,8 +566,8 @@ public:
   /** @brief Iterator type for this zipper. */
   using Iterator = ZipperIterator<Comps...>;
 
-  /** @brief Tuple type containing iterators for all Comps. */
-  using IteratorTuple = typename Iterator::iterator_tuple;
+  /** @brief Tuple type containing the storage of all Comps. */
+  using StorageTuple = typename Iterator::StorageTuple;
 
   /**
    * @brief Constructs a zipper from multiple Comp references.
@@ -338,9 +575,8 @@ public:
    * @param min_scene_level Minimum scene state level to include (default:
    * ACTIVE)
    *
-   * Computes the minimum size among all Comps and creates begin/end
-   * iterator tuples. The zipper will iterate up to the size of the smallest
-   * Comp.
+   * Keeps a pointer to each Comp storage and picks the one with the fewest
+   * live components as the driver of the iteration.
    *
    * The min_scene_level parameter controls which scenes are included:
    * - SceneState::DISABLED: Include all scenes (no filtering)
@@ -348,13 +584,32 @@ public:
    * - SceneState::MAIN: Include only MAIN scenes
    */
   Zipper(Registry& r, SceneState min_scene_level = SceneState::ACTIVE)
-      : _size(compute_size(r))
-      , _begin(std::make_tuple(r.get_components<Comps>().begin()...))
-      , _end(compute_end(r))
+      : Zipper(r, r.changes_since(), min_scene_level)
+  {
+  }
+
+  /**
+   * @brief Constructs a zipper with an explicit change threshold.
+   * @param r Registry reference containing all components and scene data
+   * @param since Oldest change tick accepted by Changed and Added filters,
+   * typically a Registry::change_tick() saved earlier
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   */
+  Zipper(Registry& r,
+         ChangeTick since,
+         SceneState min_scene_level = SceneState::ACTIVE)
+      : _loop(r)
+      , _storages(std::make_tuple(
+          &r.get_components<
+              std::remove_const_t<zipper_component_t<Comps>>>()...))
+      , _tag_matches(zipper_tag_matches(_storages))
+      , _driver(this->_tag_matches ? this->_tag_matches.get()
+                                   : zipper_driver(_storages))
       , _scenes(r.get_components<Scene>())
-      , _active_scenes(r.get_active_scenes_set())
-      , _scene_states(r.get_scene_states())
+      , _scene_masks(r.get_scene_masks())
       , _min_scene_level(min_scene_level)
+      , _since(since)
   {
   }
 
@@ -365,13 +620,13 @@ public:
    */
   Iterator begin()
   {
-    return ZipperIterator<Comps...>(this->_begin,
+    return ZipperIterator<Comps...>(this->_storages,
+                                    this->_driver,
                                     this->_scenes,
-                                    this->_active_scenes,
-                                    this->_scene_states,
-                                    this->_size,
+                                    this->_scene_masks,
                                     0,
-                                    this->_min_scene_level);
+                                    this->_min_scene_level,
+                                    this->_since);
   }
 
   /**
@@ -380,42 +635,24 @@ public:
    */
   Iterator end()
   {
-    return ZipperIterator<Comps...>(this->_end,
+    return ZipperIterator<Comps...>(this->_storages,
+                                    this->_driver,
                                     this->_scenes,
-                                    this->_active_scenes,
-                                    this->_scene_states,
-                                    this->_size,
-                                    this->_size,
-                                    this->_min_scene_level);
+                                    this->_scene_masks,
+                                    SparseArray<Scene>::npos,
+                                    this->_min_scene_level,
+                                    this->_since);
   }
 
 private:
-  /**
-   * @brief Computes the minimum size among all provided Comps.
-   * @param Comps Variadic pack of Comp references.
-   * @return Size of the smallest Comp.
-   */
-  static std::size_t compute_size(Registry const& r)
-  {
-    return std::min({r.get_components<Comps>().size()...});
-  }
-
-  /**
-   * @brief Computes the end iterator tuple for all Comps.
-   * @param Comps Variadic pack of Comp references.
-   * @return Tuple of iterators, each positioned at begin() + min_size for its
-   * Comp.
-   */
-  IteratorTuple compute_end(Registry& r)
-  {
-    return std::make_tuple(r.get_components<Comps>().begin() + _size...);
-  }
-
-  std::size_t _size;  ///< Size of the smallest Comp (iteration limit).
-  IteratorTuple _begin;  ///< Tuple of begin iterators for all Comps.
-  IteratorTuple _end;  ///< Tuple of end iterators for all Comps.
+  Registry::LoopScope _loop;  ///< Holds owning group moves back
+  StorageTuple _storages;  ///< Storage of every Comp.
+  std::shared_ptr<std::pmr::vector<std::size_t> const>
+      _tag_matches;  ///< Driver of a zipper made only of tags.
+  std::pmr::vector<std::size_t> const*
+      _driver;  ///< Packed entity list of the smallest Comp.
   SparseArray<Scene>& _scenes;
-  std::unordered_set<std::string> const& _active_scenes;
-  std::unordered_map<std::string, SceneState> const& _scene_states;
+  std::vector<std::uint8_t> const& _scene_masks;  ///< Level mask per SceneId
   SceneState _min_scene_level;  ///< Minimum scene state level to include
+  ChangeTick _since;  ///< Oldest change tick accepted by filters
 };
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 
 #include "Zipper.hpp"
 #include "ecs/Registry.hpp"
@@ -18,9 +19,7 @@
  * index to the tuple of values. It allows tracking both the position in the
  * iteration and the actual values from each container.
  *
- * @note The index represents the logical position in the iteration, which may
- * differ from the actual container indices due to skipped empty optional
- * values.
+ * @note The index is the entity id owning the yielded values.
  * @note Uses ZipperIterator as a base for the core iteration logic.
  *
  * @code
@@ -115,7 +114,7 @@ public:
    */
   bool operator==(ZipperIndexIterator const& rhs)
   {
-    return this->_base._idx == rhs._base._idx;
+    return this->_base == rhs._base;
   }
 
   /**
@@ -126,6 +125,12 @@ public:
    */
   bool operator!=(ZipperIndexIterator const& rhs) { return !(*this == rhs); }
 
+  /**
+   * @brief Current position in the driver list.
+   * @return Same as ZipperIterator::position().
+   */
+  std::size_t position() const { return this->_base.position(); }
+
 private:
   Base _base;  ///< Underlying ZipperIterator that provides the core iteration
                ///< logic.
@@ -143,9 +148,9 @@ private:
  * position during iteration, for example when processing entities by their
  * index or performing indexed operations.
  *
- * @note The index is the logical iteration position, not necessarily the
- * container index, since positions with empty optionals are skipped.
- * @note Like Zipper, it respects the size of the smallest container.
+ * @note The index is the entity id owning the yielded values.
+ * @note Like Zipper, the container with the fewest live components drives
+ * the iteration.
  *
  * @code
  * SparseArray<Position> positions;
@@ -164,8 +169,8 @@ public:
   /** @brief Iterator type for this indexed zipper. */
   using Iterator = ZipperIndexIterator<Comps...>;
 
-  /** @brief Tuple type containing iterators for all Comps. */
-  using IteratorTuple = typename Iterator::Base::iterator_tuple;
+  /** @brief Tuple type containing the storage of all Comps. */
+  using StorageTuple = typename Iterator::Base::StorageTuple;
 
   /**
    * @brief Constructs an indexed zipper from multiple container references.
@@ -173,9 +178,9 @@ public:
    * @param min_scene_level Minimum scene state level to include (default:
    * ACTIVE)
    *
-   * Computes the minimum size among all Comps and creates begin/end
-   * iterator tuples. The zipper will iterate up to the size of the smallest
-   * container, yielding tuples that include the iteration index.
+   * Keeps a pointer to each Comp storage and picks the one with the fewest
+   * live components as the driver of the iteration, yielding tuples that
+   * include the entity index.
    *
    * The min_scene_level parameter controls which scenes are included:
    * - SceneState::DISABLED: Include all scenes (no filtering)
@@ -183,13 +188,33 @@ public:
    * - SceneState::MAIN: Include only MAIN scenes
    */
   ZipperIndex(Registry& r, SceneState min_scene_level = SceneState::ACTIVE)
-      : _size(compute_size(r))
-      , _begin(std::make_tuple(r.get_components<Comps>().begin()...))
-      , _end(compute_end(r))
+      : ZipperIndex(r, r.changes_since(), min_scene_level)
+  {
+  }
+
+  /**
+   * @brief Constructs a zipper with an explicit change threshold.
+   * @param r Registry reference containing all components and scene data
+   * @param since Oldest change tick accepted by Changed and Added filters,
+   * typically a Registry::change_tick() saved earlier
+   * @param min_scene_level Minimum scene state level to include (default:
+   * ACTIVE)
+   */
+  ZipperIndex(Registry& r,
+              ChangeTick since,
+              SceneState min_scene_level = SceneState::ACTIVE)
+      : _registry(r)
+      , _loop(r)
+      , _storages(std::make_tuple(
+          &r.get_components<
+              std::remove_const_t<zipper_component_t<Comps>>>()...))
+      , _tag_matches(zipper_tag_matches(_storages))
+      , _driver(this->_tag_matches ? this->_tag_matches.get()
+                                   : zipper_driver(_storages))
       , _scenes(r.get_components<Scene>())
-      , _active_scenes(r.get_active_scenes_set())
-      , _scene_states(r.get_scene_states())
+      , _scene_masks(r.get_scene_masks())
       , _min_scene_level(min_scene_level)
+      , _since(since)
   {
   }
 
@@ -198,17 +223,17 @@ public:
    * @return ZipperIndexIterator positioned at the first valid element.
    *
    * The returned iterator will yield tuples of (index, value1, value2, ...)
-   * where index starts at 0 and increments for each valid position.
+   * where index is the entity owning the values.
    */
   Iterator begin()
   {
-    return ZipperIndexIterator<Comps...>(this->_begin,
+    return ZipperIndexIterator<Comps...>(this->_storages,
+                                         this->_driver,
                                          this->_scenes,
-                                         this->_active_scenes,
-                                         this->_scene_states,
-                                         this->_size,
+                                         this->_scene_masks,
                                          0,
-                                         this->_min_scene_level);
+                                         this->_min_scene_level,
+                                         this->_since);
   }
 
   /**
@@ -217,42 +242,78 @@ public:
    */
   Iterator end()
   {
-    return ZipperIndexIterator<Comps...>(this->_end,
+    return ZipperIndexIterator<Comps...>(this->_storages,
+                                         this->_driver,
                                          this->_scenes,
-                                         this->_active_scenes,
-                                         this->_scene_states,
-                                         this->_size,
-                                         this->_size,
-                                         this->_min_scene_level);
+                                         this->_scene_masks,
+                                         SparseArray<Scene>::npos,
+                                         this->_min_scene_level,
+                                         this->_since);
   }
 
-private:
   /**
-   * @brief Computes the minimum size among all provided Comps.
-   * @param Comps Variadic pack of container references.
-   * @return Size of the smallest container.
+   * @brief Calls fn for every matching entity, spread over the worker pool.
+   * @tparam Function Callable type (deduced)
+   * @param fn Called as fn(index, comps...) with the same arguments a range
+   * for loop would bind, possibly from several threads at once
+   *
+   * The driver list is cut into chunks of zipper_chunk_size() entries, each
+   * chunk is walked in order by one thread. Returns once every entity has
+   * been visited.
+   *
+   * @warning fn may only modify the components of the entity it receives.
+   * Emitting events or changing the structure of the Registry must go through
+   * Registry::defer(), the deferred actions run after the loop in entity
+   * order.
+   *
+   * @code
+   * double dt = r.clock().delta_seconds();
+   * ZipperIndex<Position, Speed const>(r).par_each(
+   *   [dt](std::size_t, Position& pos, Speed const& speed) {
+   *     pos.pos += speed.speed * dt;
+   *   });
+   * @endcode
    */
-  static std::size_t compute_size(Registry const& r)
+  template<class Function>
+  void par_each(Function&& fn)
   {
-    return std::min({r.get_components<Comps>().size()...});
-  }
+    if (this->_driver == nullptr) {
+      return;
+    }
+    std::size_t total = this->_driver->size();
+    std::size_t chunk = zipper_chunk_size<Comps...>();
 
-  /**
-   * @brief Computes the end iterator tuple for all Comps.
-   * @param Comps Variadic pack of container references.
-   * @return Tuple of iterators, each positioned at begin() + min_size for its
-   * container.
-   */
-  IteratorTuple compute_end(Registry& r)
-  {
-    return std::make_tuple(r.get_components<Comps>().begin() + _size...);
+    this->_registry.run_parallel(
+        (total + chunk - 1) / chunk,
+        [this, &fn, total, chunk](std::size_t c)
+        {
+          std::size_t last = std::min(total, (c + 1) * chunk);
+
+          for (Iterator it(this->_storages,
+                           this->_driver,
+                           this->_scenes,
+                           this->_scene_masks,
+                           c * chunk,
+                           this->_min_scene_level,
+                           this->_since);
+               it.position() < last;
+               ++it)
+          {
+            std::apply(fn, *it);
+          }
+        });
   }
 
-  std::size_t _size;  ///< Size of the smallest Comp (iteration limit).
-  IteratorTuple _begin;  ///< Tuple of begin iterators for all Comps.
-  IteratorTuple _end;  ///< Tuple of end iterators for all Comps.
+private:
+  Registry& _registry;  ///< Provides the worker pool of par_each().
+  Registry::LoopScope _loop;  ///< Holds owning group moves back
+  StorageTuple _storages;  ///< Storage of every Comp.
+  std::shared_ptr<std::pmr::vector<std::size_t> const>
+      _tag_matches;  ///< Driver of a zipper made only of tags.
+  std::pmr::vector<std::size_t> const*
+      _driver;  ///< Packed entity list of the smallest Comp.
   SparseArray<Scene>& _scenes;
-  std::unordered_set<std::string> const& _active_scenes;
-  std::unordered_map<std::string, SceneState> const& _scene_states;
+  std::vector<std::uint8_t> const& _scene_masks;  ///< Level mask per SceneId
   SceneState _min_scene_level;  ///< Minimum scene state level to include
+  ChangeTick _since;  ///< Oldest change tick accepted by filters
 };
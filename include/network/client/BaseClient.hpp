@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -35,9 +36,10 @@ public:
 
 private:
   void setup_http_requests();
-  void connection_thread(ClientConnection const& c);
-  SharedQueue<ComponentBuilder> _component_queue;
-  SharedQueue<EventBuilder> _event_from_server;
+  void connection_thread(ClientConnection const& c,
+                         std::vector<std::string> local_events);
+  MpscRing<ComponentBuilder> _component_queue;  ///< Drained each frame
+  MpscRing<EventBuilder> _event_from_server;  ///< Drained each frame
   SharedQueue<EventBuilder> _event_to_server;
 
   // std::optional<Client> _client_class;
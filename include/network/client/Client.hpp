@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -31,10 +32,11 @@ class Client
 {
 public:
   Client(ClientConnection const& c,
-         SharedQueue<ComponentBuilder>&,
+         MpscRing<ComponentBuilder>&,
          SharedQueue<EventBuilder>&,
-         SharedQueue<EventBuilder>&,
-         std::atomic<bool>& running);
+         MpscRing<EventBuilder>&,
+         std::atomic<bool>& running,
+         std::vector<std::string> local_events = {});
   ~Client();
 
   bool should_disconnect() const;
@@ -54,6 +56,8 @@ private:
 
   void handle_component_update(ByteArray const& package);
   void handle_event_creation(ByteArray const& package);
+  void handle_event_id(ByteArray const& package);
+  void handle_event_table(ByteArray const& package);
   void reset_acknowledge(ByteArray const&);
 
   void send_getchallenge(int id);
@@ -78,6 +82,10 @@ private:
       ByteArray const& package);
   static std::optional<EventBuilder> parse_event_build_cmd(
       ByteArray const& package);
+  static std::optional<EventIdCommand> parse_event_id_build_cmd(
+      ByteArray const& package);
+  static std::optional<std::vector<std::string>> parse_event_table_cmd(
+      ByteArray const& package);
   static std::optional<ComponentBuilder> parse_component_build_cmd(
       ByteArray const& package);
   static std::optional<HearthBeat> parse_hearthbeat_cmd(
@@ -107,16 +115,28 @@ private:
   std::string _player_name = "Player";
   ByteArray _receive_frag_buffer;
 
-  std::reference_wrapper<SharedQueue<ComponentBuilder>> _components_to_create;
+  std::reference_wrapper<MpscRing<ComponentBuilder>> _components_to_create;
   std::reference_wrapper<SharedQueue<EventBuilder>> _events_to_transmit;
-  std::reference_wrapper<SharedQueue<EventBuilder>> _event_to_exec;
+  std::reference_wrapper<MpscRing<EventBuilder>> _event_to_exec;
   std::reference_wrapper<std::atomic<bool>> _running;
 
   // std::unordered_map<std::uint32_t, ByteArray> _waiting_packages;
 
   void send_evt();
+  ByteArray encode_event(EventBuilder const& event) const;
   std::thread _queue_reader;
 
+  /**
+   * Event names of the game EventManager when connecting, indexed by local
+   * EventTypeId. The id tables below are filled from the first server table,
+   * then only read. Every table received is acknowledged, the server keeps
+   * sending events by name until then.
+   */
+  std::vector<std::string> _local_events;
+  std::vector<std::optional<std::size_t>> _server_to_local;
+  std::vector<std::optional<std::uint32_t>> _local_to_server;
+  std::atomic<bool> _event_table_ready = false;
+
   void send_hearthbeat();
   std::thread _hearthbeat;
   static const std::size_t hearthbeat_delta = 1000000000 / 15;
@@ -125,6 +145,8 @@ private:
   std::atomic<std::size_t> _last_ping;
   static const std::size_t disconnection_timeout = 1500000000;  // 15 seconds
 
+  // send_connected() runs on both the receive and the event threads
+  std::mutex _send_mutex;
   std::size_t _index_sequence = 1;
   std::mutex _acknowledge_mutex;
   AcknowledgeManager _acknowledge_manager;
@@ -49,7 +49,7 @@ private:
   std::thread _actual_server;
   SharedQueue<ComponentBuilderId> _components_to_update;
   std::atomic<bool> _running = false;
-  SharedQueue<EventBuilder> _event_queue;
+  MpscRing<EventBuilder> _event_queue;  ///< Receive threads to frame loop
   SharedQueue<EventBuilderId> _event_queue_to_client;
 
 protected:
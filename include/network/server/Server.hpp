@@ -10,6 +10,8 @@
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -31,8 +33,9 @@ public:
   Server(ServerLaunching const& s,
          SharedQueue<ComponentBuilderId>& comp_queue,
          SharedQueue<EventBuilderId>& event_to_client,
-         SharedQueue<EventBuilder>& event_to_server,
-         std::atomic<bool>& running);
+         MpscRing<EventBuilder>& event_to_server,
+         std::atomic<bool>& running,
+         std::vector<std::string> event_names = {});
   ~Server();
 
   void close();
@@ -65,6 +68,10 @@ private:
                       const asio::ip::udp::endpoint& sender);
 
   void handle_event_receive(ByteArray const&, const asio::ip::udp::endpoint&);
+  void handle_event_id_receive(ByteArray const&,
+                               const asio::ip::udp::endpoint&);
+  void handle_event_table_ack(ByteArray const&,
+                              const asio::ip::udp::endpoint&);
   void handle_hearthbeat(ByteArray const&, const asio::ip::udp::endpoint&);
 
   void handle_package(ByteArray const&, const asio::ip::udp::endpoint&);
@@ -81,6 +88,8 @@ private:
       ByteArray const& package);
   static std::optional<EventBuilder> parse_event_build_cmd(
       ByteArray const& package);
+  static std::optional<EventIdCommand> parse_event_id_build_cmd(
+      ByteArray const& package);
   static std::optional<ComponentBuilder> parse_component_build_cmd(
       ByteArray const& package);
   static std::optional<HearthBeat> parse_hearthbeat_cmd(
@@ -119,10 +128,24 @@ private:
 
   void transmit_event_to_client(EventBuilderId const& to_transmit);
   void send_event_to_client();
+  std::optional<ByteArray> encode_event_id(EventBuilder const& event) const;
+  ByteArray encode_event_name(EventBuilder const& event) const;
   std::reference_wrapper<SharedQueue<EventBuilderId>> _events_queue_to_client;
 
   void transmit_event_to_server(EventBuilder const& to_transmit);
-  std::reference_wrapper<SharedQueue<EventBuilder>> _events_queue_to_serv;
+  std::reference_wrapper<MpscRing<EventBuilder>> _events_queue_to_serv;
+
+  /**
+   * Event names of the game EventManager when the server was launched,
+   * indexed by EventTypeId. Sent to every client on connection and after
+   * each reset, events travel by id to the clients that acknowledged it and
+   * by name to the others. Read-only once constructed.
+   */
+  std::vector<std::string> _event_names;
+  std::unordered_map<std::string, std::uint32_t> _event_ids;
+
+  static const std::size_t event_table_resend_delta = 500000000;  // 0.5 second
+  void send_event_table(ClientInfo& client);
 
   std::atomic<bool>& _running;
 
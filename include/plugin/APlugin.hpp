@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <optional>
+#include <span>
 #include <string>
 
 #include "EntityLoader.hpp"
@@ -60,11 +61,20 @@
       #event_name, \
       [this]([[maybe_unused]] event_name const& event) -> bool \
       { function return false; }, \
-      priority);
+      priority, \
+      this->name);
 
 #define SUBSCRIBE_EVENT(event_name, function) \
   SUBSCRIBE_EVENT_PRIORITY(event_name, function, 1)
 
+#define SUBSCRIBE_EVENT_BATCH(event_name, function) \
+  this->_event_manager.get().on_batch<event_name>( \
+      #event_name, \
+      [this]([[maybe_unused]] std::span<event_name const> events) -> bool \
+      { function return false; }, \
+      1, \
+      this->name);
+
 class APlugin : public IPlugin
 {
 public:
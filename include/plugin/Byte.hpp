@@ -6,7 +6,9 @@
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "CustomException.hpp"
@@ -271,13 +273,18 @@ ByteArray pair_to_byte(std::pair<Key, Value> p,
  * @brief Serializes an unordered_map to ByteArray
  * @tparam Key Key type
  * @tparam Value Value type
+ * @tparam Alloc Allocator of the map, std::pmr maps included
  * @param m Map to serialize
  * @param f1 Function to serialize keys
  * @param f2 Function to serialize values
  * @return ByteArray: size followed by serialized key-value pairs
  */
-template<typename Key, typename Value>
-ByteArray map_to_byte(std::unordered_map<Key, Value> const& m,
+template<typename Key,
+         typename Value,
+         typename Alloc = std::allocator<std::pair<Key const, Value>>>
+ByteArray map_to_byte(
+    std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, Alloc>
+        const& m,
                       std::function<ByteArray(Key const&)> f1,
                       std::function<ByteArray(Value const&)> f2)
 {
@@ -308,7 +315,7 @@ ByteArray optional_to_byte(std::optional<T> const& m,
  * @param str String to serialize
  * @return ByteArray: length (uint32) followed by UTF-8 bytes
  */
-ByteArray string_to_byte(std::string const& str);
+ByteArray string_to_byte(std::string_view str);
 
 /**
  * @brief Serializes a JsonValue (variant type)
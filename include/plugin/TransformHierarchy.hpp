@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ecs/ChangeTick.hpp"
+#include "ecs/Entity.hpp"
+#include "ecs/Registry.hpp"
+#include "ecs/SparseArray.hpp"
+#include "ecs/zipper/Zipper.hpp"
+#include "plugin/components/Position.hpp"
+
+/**
+ * @class TransformHierarchy
+ * @brief Keeps the entities attached with a Parent on their parent
+ *
+ * The Position of a child is set to the world position of its parent (the
+ * parent Position plus its Offset), its own Offset then places it relative
+ * to the parent wherever world_position() is read. Parents are handled
+ * before their children, so a chain follows its root in a single update.
+ *
+ * The children are kept sorted by depth between updates and only sorted
+ * again when a Parent is added, removed or retargeted.
+ *
+ * The world position of every child is cached. A child is only recomputed
+ * when its own Position, Offset or Parent changed since the last update, or
+ * when its parent moved, so a still hierarchy costs a few tick comparisons.
+ * Changes are read from the change ticks: Positions written through
+ * operator[] or a hook are not seen, write them with modify().
+ *
+ * @code
+ * std::vector<Ecs::Entity> moved;
+ * hierarchy.update(r, moved);
+ * // moved: children whose Position was written, to send over the network
+ * @endcode
+ */
+class TransformHierarchy
+{
+public:
+  /**
+   * @brief Moves every child whose parent moved
+   *
+   * @param r Registry holding the Position, Offset and Parent storages
+   * @param moved Receives the children whose Position was written
+   */
+  void update(Registry& r, std::vector<Ecs::Entity>& moved)
+  {
+    auto& positions = r.get_components<Position>();
+    auto const& offsets = r.get_components<Offset>();
+    auto const& parents = r.get_components<Parent>();
+
+    if (this->is_stale(r, parents)) {
+      this->sort(parents);
+      this->_sorted_at = r.change_tick();
+    }
+    // Inclusive, writes made later in the tick of the last update count
+    ChangeTick since = this->_updated_at;
+    this->_updated_at = r.change_tick();
+
+    for (std::size_t i = 0; i < this->_children.size(); i++) {
+      Ecs::Entity e = this->_children[i].second;
+      Node& node = this->_nodes[i];
+      auto const& parent = parents[e];
+
+      node.recomputed = false;
+      if (!parent.has_value() || !positions[e].has_value()
+          || !positions[parent->entity].has_value())
+      {
+        node.valid = false;
+        continue;
+      }
+      if (!this->is_dirty(node, e, parent->entity, since, r)) {
+        continue;
+      }
+      Vector2D anchor = this->world_of(node, parent->entity, r);
+
+      if (positions[e]->pos != anchor) {
+        positions.modify(e)->pos = anchor;
+        moved.push_back(e);
+      }
+      node.world = world_position(offsets, e, *positions[e]);
+      node.offset = offsets.contains(e);
+      node.parent_offset = offsets.contains(parent->entity);
+      node.valid = true;
+      node.recomputed = true;
+    }
+  }
+
+  /**
+   * @brief Attached entities, parents before their children
+   */
+  std::vector<std::pair<std::size_t, Ecs::Entity>> const& order() const
+  {
+    return this->_children;
+  }
+
+private:
+  static constexpr std::size_t npos = SparseArray<Parent>::npos;
+
+  /// Cached state of one child, at the same index as in _children
+  struct Node
+  {
+    std::size_t parent = npos;  ///< Index of the parent node, npos for a root
+    Vector2D world;  ///< Position plus Offset at the last recompute
+    bool offset = false;  ///< The child had an Offset at the last recompute
+    bool parent_offset = false;  ///< Same for the parent
+    bool valid = false;  ///< world is up to date as of the last update
+    bool recomputed = false;  ///< world was recomputed by this update
+  };
+
+  template<class Storage>
+  static bool changed(Storage const& storage, std::size_t e, ChangeTick since)
+  {
+    return storage.contains(e) && storage.changed_tick(e) >= since;
+  }
+
+  /**
+   * @brief Whether the child or one of its ancestors moved since the last
+   * update
+   *
+   * A parent that is itself cached answers through its node, parents
+   * handled earlier in this update, only roots are read from their storages.
+   * Removing an Offset stamps nothing, its presence is compared instead.
+   */
+  bool is_dirty(Node const& node,
+                Ecs::Entity e,
+                Ecs::Entity parent,
+                ChangeTick since,
+                Registry& r) const
+  {
+    auto const& positions = r.get_components<Position>();
+    auto const& offsets = r.get_components<Offset>();
+
+    if (!node.valid || changed(positions, e, since)
+        || changed(offsets, e, since)
+        || changed(r.get_components<Parent>(), e, since)
+        || offsets.contains(e) != node.offset)
+    {
+      return true;
+    }
+    if (node.parent != npos && this->_nodes[node.parent].valid) {
+      return this->_nodes[node.parent].recomputed;
+    }
+    return changed(positions, parent, since) || changed(offsets, parent, since)
+        || offsets.contains(parent) != node.parent_offset;
+  }
+
+  Vector2D world_of(Node const& node, Ecs::Entity parent, Registry& r) const
+  {
+    if (node.parent != npos && this->_nodes[node.parent].valid) {
+      return this->_nodes[node.parent].world;
+    }
+    return world_position(r.get_components<Offset>(),
+                          parent,
+                          *r.get_components<Position>()[parent]);
+  }
+
+  bool is_stale(Registry& r, SparseArray<Parent> const& parents) const
+  {
+    // A removal changes the count, an addition or a retarget its tick
+    if (this->_children.size() != parents.count()) {
+      return true;
+    }
+    Zipper<Changed<Parent const>> changed(
+        r, this->_sorted_at, SceneState::DISABLED);
+
+    return changed.begin() != changed.end();
+  }
+
+  void sort(SparseArray<Parent> const& parents)
+  {
+    this->_children.clear();
+    for (std::size_t e : parents.entities()) {
+      std::size_t depth = 0;
+      std::size_t up = e;
+
+      // Bounded by the parent count so that a cycle cannot loop forever
+      while (parents[up].has_value() && depth <= parents.count()) {
+        up = parents[up]->entity;
+        depth++;
+      }
+      this->_children.emplace_back(depth, e);
+    }
+    std::ranges::sort(this->_children);
+
+    // Every cache is dropped, children are recomputed on the next pass
+    std::unordered_map<Ecs::Entity, std::size_t> index;
+    for (std::size_t i = 0; i < this->_children.size(); i++) {
+      index.emplace(this->_children[i].second, i);
+    }
+    this->_nodes.assign(this->_children.size(), Node {});
+    for (std::size_t i = 0; i < this->_children.size(); i++) {
+      auto it = index.find(parents[this->_children[i].second]->entity);
+
+      if (it != index.end()) {
+        this->_nodes[i].parent = it->second;
+      }
+    }
+  }
+
+  std::vector<std::pair<std::size_t, Ecs::Entity>>
+      _children;  ///< (depth, entity) of every Parent owner
+  std::vector<Node> _nodes;  ///< Cache of each child, in _children order
+  ChangeTick _sorted_at = 0;  ///< Registry change tick of the last sort
+  ChangeTick _updated_at = 0;  ///< Registry change tick of the last update
+};
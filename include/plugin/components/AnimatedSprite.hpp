@@ -8,6 +8,8 @@
 #ifndef ANIMATED_SPRITE_HPP_
 #define ANIMATED_SPRITE_HPP_
 
+#include <iterator>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 
@@ -179,22 +181,53 @@ inline Parser<AnimationData> parseAnimationData()
       parseByte<bool>());
 }
 
+/**
+ * @brief Sprite cycling through named animations.
+ *
+ * The animation table is allocator-aware: the AnimatedSprite storage copies
+ * it into the Registry's memory resource, see SparseArray.
+ */
 class AnimatedSprite
 {
 public:
-  AnimatedSprite(std::unordered_map<std::string, AnimationData> animations,
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+  using Animations = std::pmr::unordered_map<std::string, AnimationData>;
+
+  AnimatedSprite(Animations animations,
                  std::string current_animation,
-                 std::string default_animation)
-      : animations(std::move(animations))
+                 std::string default_animation,
+                 allocator_type alloc = {})
+      : animations(std::move(animations), alloc)
       , current_animation(std::move(current_animation))
       , default_animation(std::move(default_animation))
   {
     this->last_update = std::chrono::high_resolution_clock::now();
   };
 
+  AnimatedSprite(AnimatedSprite const& other, allocator_type alloc)
+      : animations(other.animations, alloc)
+      , current_animation(other.current_animation)
+      , default_animation(other.default_animation)
+      , last_update(other.last_update)
+  {
+  }
+
+  AnimatedSprite(AnimatedSprite&& other, allocator_type alloc)
+      : animations(std::move(other.animations), alloc)
+      , current_animation(std::move(other.current_animation))
+      , default_animation(std::move(other.default_animation))
+      , last_update(other.last_update)
+  {
+  }
+
+  AnimatedSprite(AnimatedSprite const&) = default;
+  AnimatedSprite(AnimatedSprite&&) = default;
+  AnimatedSprite& operator=(AnimatedSprite const&) = default;
+  AnimatedSprite& operator=(AnimatedSprite&&) = default;
+
   ~AnimatedSprite() = default;
 
-  std::unordered_map<std::string, AnimationData> animations;
+  Animations animations;
   std::string current_animation;
   std::string default_animation = "";
 
@@ -227,9 +260,11 @@ public:
              std::string current_animation,
              std::string default_animation)
           {
-            return AnimatedSprite(std::move(animations),
-                                  std::move(current_animation),
-                                  std::move(default_animation));
+            return AnimatedSprite(
+                Animations(std::make_move_iterator(animations.begin()),
+                           std::make_move_iterator(animations.end())),
+                std::move(current_animation),
+                std::move(default_animation));
           }),
       parseByteMap(parseByteString(), parseAnimationData()),
       parseByteString(),
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
+
 #include "ByteParser/ByteParser.hpp"
 #include "libs/Vector2D.hpp"
 #include "plugin/Byte.hpp"
 #include "plugin/Hooks.hpp"
+#include "plugin/events/EventMacros.hpp"
 
 struct Position
 {
@@ -30,12 +33,19 @@ struct Position
 
   CHANGE_ENTITY_DEFAULT
 
-  Vector2D pos;
+  Vector2D pos;  ///< Without the Offset, see world_position()
   int z;
-  bool applied_offset = false;
   HOOKABLE(Position, HOOK(pos), HOOK(pos.x), HOOK(pos.y), HOOK(z))
 };
 
+/**
+ * @brief Displacement of an entity from its Position
+ *
+ * Never folded into Position: it is added where the entity is drawn or
+ * collides, see world_position(), so code writing Position keeps it. With a
+ * Parent, Position follows the parent and the offset places the entity
+ * relative to it.
+ */
 struct Offset
 {
   Offset() = default;
@@ -61,3 +71,49 @@ struct Offset
   Vector2D offset;
   HOOKABLE(Offset, HOOK(offset))
 };
+
+/**
+ * @brief Attaches an entity to another one
+ *
+ * The moving plugin keeps the Position of the entity on the world position
+ * of entity, parents before their children, so the entity sits at that
+ * position plus its own Offset.
+ */
+struct Parent
+{
+  Parent() = default;
+
+  Parent(std::size_t entity)
+      : entity(entity)
+  {
+  }
+
+  DEFAULT_BYTE_CONSTRUCTOR(Parent,
+                           ([](std::size_t entity) { return Parent {entity}; }),
+                           parseByte<std::size_t>())
+
+  DEFAULT_SERIALIZE(type_to_byte(this->entity))
+
+  CHANGE_ENTITY(result.entity = map.at(entity))
+
+  HOOKABLE(Parent, HOOK(entity))
+
+  std::size_t entity = 0;
+};
+
+/**
+ * @brief Where an entity is drawn and collides: its Position plus its Offset
+ *
+ * @param offsets Offset storage, Registry::get_components<Offset>()
+ * @param entity The entity owning pos
+ * @param pos Position of the entity
+ */
+template<class Offsets>
+Vector2D world_position(Offsets const& offsets,
+                        std::size_t entity,
+                        Position const& pos)
+{
+  auto const& offset = offsets[entity];
+
+  return offset.has_value() ? pos.pos + offset->offset : pos.pos;
+}
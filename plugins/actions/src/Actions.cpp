@@ -9,6 +9,7 @@
 
 #include "Json/JsonParser.hpp"
 #include "TwoWayMap.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/InitComponent.hpp"
 #include "ecs/zipper/ZipperIndex.hpp"
 #include "plugin/APlugin.hpp"
@@ -39,10 +40,10 @@ Actions::Actions(Registry& r, EventManager& em, EntityLoader& l)
       5);
 
   SUBSCRIBE_EVENT(KeyPressedEvent, {
-    std::vector<std::function<void()>> to_emit;
+    CommandBuffer to_emit;
 
     for (auto&& [entity, action] :
-         ZipperIndex<ActionTrigger>(this->_registry.get()))
+         ZipperIndex<ActionTrigger const>(this->_registry.get()))
     {
       if (!this->_registry.get().is_in_main_scene(entity)
           || action.event_trigger.first != "KeyPressed")
@@ -55,18 +56,11 @@ Actions::Actions(Registry& r, EventManager& em, EntityLoader& l)
               KEY_MAPPING.at_first(key)))
       {
         for (auto& i : action.event_to_emit) {
-          to_emit.emplace_back(
-              [this, i, entity]()
-              {
-                this->_event_manager.get().emit(
-                    this->_registry.get(), i.first, i.second, entity);
-              });
+          to_emit.emit(i.first, i.second, entity);
         }
       }
     }
-    for (auto const& it : to_emit) {
-      it();
-    }
+    to_emit.apply(this->_registry.get(), this->_event_manager.get());
   })
 }
 
@@ -4,6 +4,7 @@
 
 #include "Json/JsonParser.hpp"
 #include "attack/ContinuousFirePattern.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/zipper/ZipperIndex.hpp"
 #include "movement/CirclePattern.hpp"
 #include "movement/FollowTargetPattern.hpp"
@@ -19,6 +20,36 @@
 #include "plugin/components/Position.hpp"
 #include "plugin/components/Speed.hpp"
 
+namespace
+{
+/**
+ * @brief Runs one attack pattern once the system's batch is applied
+ *
+ * Recorded per attacking entity: three scalars instead of a closure, the
+ * components are fetched when applied since the pattern may spawn entities.
+ */
+struct AttackCommand
+{
+  void operator()(Registry& r, EventManager& em) const
+  {
+    auto& behavior = r.get_components<AttackBehavior>()[entity];
+    auto& pos = r.get_components<Position>()[entity];
+    auto& speed = r.get_components<Speed>()[entity];
+    auto& direction = r.get_components<Direction>()[entity];
+
+    if (!behavior || !pos || !speed || !direction) {
+      return;
+    }
+    pattern->execute(
+        entity, r, em, *behavior, *pos, *direction, *speed, dt);
+  }
+
+  Ecs::Entity entity;
+  AttackPattern* pattern;
+  double dt;
+};
+}  // namespace
+
 AI::AI(Registry& r, EventManager& em, EntityLoader& l)
     : APlugin("ai",
               r,
@@ -43,6 +74,8 @@ AI::AI(Registry& r, EventManager& em, EntityLoader& l)
   _attack_patterns["continuous"] = std::make_unique<ContinuousFirePattern>();
   // _attack_patterns["aimed"] = std::make_unique<AimedFirePattern>();
 
+  // Not concurrent: patterns resolve hooks, which read any component, and
+  // add Follower, InteractionZone or Parasite on the fly
   _registry.get().add_system(
       [this](Registry& r) { movement_behavior_system(r); }, 2);
   _registry.get().add_system([this](Registry& r) { attack_behavior_system(r); },
@@ -116,9 +149,11 @@ void AI::attack_behavior_system(Registry& r)
 {
   double dt = r.clock().delta_seconds();
 
-  std::vector<std::function<void()>> to_exec;
   for (auto&& index :
-       ZipperIndex<AttackBehavior, Position, Direction, Speed>(r))
+       ZipperIndex<AttackBehavior const,
+                   Position const,
+                   Direction const,
+                   Speed const>(r))
   {
     std::size_t entity = std::get<0>(index);
     AttackBehavior const& behavior = std::get<1>(index);
@@ -127,32 +162,10 @@ void AI::attack_behavior_system(Registry& r)
     }
 
     if (_attack_patterns.contains(behavior.attack_type)) {
-      auto* pattern = _attack_patterns[behavior.attack_type].get();
-      to_exec.emplace_back(
-          [this, entity, pattern, dt]()
-          {
-            auto& behavior =
-                *this->_registry.get().get_components<AttackBehavior>()[entity];
-            auto& pos =
-                *this->_registry.get().get_components<Position>()[entity];
-            auto& speed =
-                *this->_registry.get().get_components<Speed>()[entity];
-            auto& direction =
-                *this->_registry.get().get_components<Direction>()[entity];
-            pattern->execute(entity,
-                             this->_registry.get(),
-                             this->_event_manager.get(),
-                             behavior,
-                             pos,
-                             direction,
-                             speed,
-                             dt);
-          });
+      r.commands().call(AttackCommand {
+          entity, _attack_patterns[behavior.attack_type].get(), dt});
     }
   }
-  for (auto const& it : to_exec) {
-    it();
-  }
 }
 
 extern "C"
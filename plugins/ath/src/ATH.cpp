@@ -24,7 +24,10 @@ static void on_click(Registry& r,
 {
   std::vector<std::function<void(void)>> to_emit;
   for (const auto& [e, draw, clickable, pos, collision] :
-       ZipperIndex<Drawable, Clickable, Position, Collidable>(r))
+       ZipperIndex<Drawable const,
+                   Clickable const,
+                   Position const,
+                   Collidable const>(r))
   {
     if (!draw.enabled || !r.is_in_main_scene(e)) {
       continue;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <thread>
@@ -22,7 +23,26 @@ public:
 private:
   void run_cli();
   void process_command(const std::string& cmd);
+  static void print_stats(Registry& r);
+  void apply_event_stats_request();
+  static void print_event_stats(EventManager& em);
+
+  /**
+   * @brief Last "events" command, applied by a system on the main thread
+   */
+  enum class EventStatsRequest : std::uint8_t
+  {
+    NONE,
+    SHOW,
+    ENABLE,
+    DISABLE,
+    RESET,
+  };
 
   std::thread _cli_thread;
   std::atomic<bool> _running = false;
+  std::atomic<bool> _stats_requested =
+      false;  ///< Set by the CLI thread, printed by a system
+  std::atomic<EventStatsRequest> _event_stats_request =
+      EventStatsRequest::NONE;
 };
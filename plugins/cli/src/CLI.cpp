@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <format>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -13,6 +16,7 @@
 #include "NetworkShared.hpp"
 #include "ServerLaunch.hpp"
 #include "ecs/EventManager.hpp"
+#include "ecs/EventStats.hpp"
 #include "ecs/Scenes.hpp"
 #include "plugin/APlugin.hpp"
 #include "plugin/components/Drawable.hpp"
@@ -39,6 +43,15 @@ CLI::CLI(Registry& r,
     }
   })
   SUBSCRIBE_EVENT(CliStop, { _running = false; })
+  // The registry is only read on the main thread, between two systems
+  this->_registry.get().add_system(
+      [this](Registry& r)
+      {
+        if (this->_stats_requested.exchange(false)) {
+          print_stats(r);
+        }
+        this->apply_event_stats_request();
+      });
   _event_manager.get().emit<CliStart>();
 }
 
@@ -234,6 +247,33 @@ void CLI::process_command(const std::string& cmd)
               42, "scene", scene.to_bytes());
         }}},
 
+      {"stats",
+       {.usage = "stats",
+        .description = "Show entity counts and memory per component",
+        .handler = [this](std::istringstream&)
+        { this->_stats_requested = true; }}},
+      {"events",
+       {.usage = "events [on|off|reset]",
+        .description = "Show time spent per event type and handler",
+        .handler =
+            [this](std::istringstream& iss)
+        {
+          static const std::map<std::string, EventStatsRequest> ACTIONS = {
+              {"", EventStatsRequest::SHOW},
+              {"on", EventStatsRequest::ENABLE},
+              {"off", EventStatsRequest::DISABLE},
+              {"reset", EventStatsRequest::RESET},
+          };
+          std::string action;
+
+          iss >> action;
+          auto it = ACTIONS.find(action);
+          if (it == ACTIONS.end()) {
+            std::cout << "Usage: events [on|off|reset]\n";
+            return;
+          }
+          this->_event_stats_request = it->second;
+        }}},
       {"stop",
        {.usage = "stop",
         .description = "Stop CLI thread",
@@ -324,6 +364,121 @@ void CLI::process_command(const std::string& cmd)
   }
 }
 
+void CLI::print_stats(Registry& r)
+{
+  RegistryStats stats = r.stats();
+
+  std::cout << "entities: " << stats.live_entities << " live, "
+            << stats.dead_ids << " dead ids, " << stats.pending_kills
+            << " dying, " << stats.entity_ids << " ids used\n"
+            << "systems: " << stats.systems << ", queries: " << stats.queries
+            << ", groups: " << stats.groups << "\n"
+            << "bindings: " << stats.bindings
+            << ", hooks: " << stats.component_hooks << " component, "
+            << stats.global_hooks << " global\n"
+            << std::left << std::setw(28) << "component" << std::right
+            << std::setw(9) << "live" << std::setw(10) << "capacity"
+            << std::setw(12) << "storage B" << std::setw(12) << "sync B"
+            << "\n";
+  for (auto const& comp : stats.components) {
+    if (comp.name.empty()) {
+      continue;
+    }
+    std::cout << std::left << std::setw(28) << comp.name << std::right
+              << std::setw(9) << comp.live << std::setw(10) << comp.capacity
+              << std::setw(12) << comp.storage_bytes << std::setw(12)
+              << comp.serialized_bytes << (comp.tag ? " tag" : "")
+              << (comp.grouped ? " grouped" : "") << "\n";
+  }
+  std::cout << "components: " << stats.component_bytes()
+            << " bytes, signatures: " << stats.signature_bytes << " bytes\n";
+}
+
+void CLI::apply_event_stats_request()
+{
+  EventManager& em = this->_event_manager.get();
+
+  switch (this->_event_stats_request.exchange(EventStatsRequest::NONE)) {
+    case EventStatsRequest::NONE:
+      break;
+    case EventStatsRequest::SHOW:
+      print_event_stats(em);
+      break;
+    case EventStatsRequest::ENABLE:
+      em.enable_stats();
+      std::cout << "Recording event stats\n";
+      break;
+    case EventStatsRequest::DISABLE:
+      em.enable_stats(false);
+      std::cout << "Event stats stopped\n";
+      break;
+    case EventStatsRequest::RESET:
+      em.reset_stats();
+      std::cout << "Event stats reset\n";
+      break;
+  }
+}
+
+namespace
+{
+void print_histogram(LatencyHistogram const& h)
+{
+  auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+  std::cout << std::format("{:10.1f}{:10.1f}{:10.1f}{:12.1f}",
+                           us(h.mean_ns()),
+                           us(h.percentile(0.99)),
+                           us(h.max_ns),
+                           us(h.total_ns));
+}
+}  // namespace
+
+void CLI::print_event_stats(EventManager& em)
+{
+  EventStats stats = em.stats();
+
+  if (!stats.enabled) {
+    std::cout << "Event stats are not recorded, use 'events on'\n";
+  }
+  // Most expensive event types first
+  std::ranges::sort(stats.events,
+                    std::ranges::greater {},
+                    [](EventTypeStats const& evt)
+                    { return evt.dispatch_time.total_ns; });
+  std::cout << std::left << std::setw(28) << "event / handler" << std::right
+            << std::setw(9) << "calls" << std::setw(10) << "prevented"
+            << std::setw(10) << "mean us" << std::setw(10) << "p99 us"
+            << std::setw(10) << "max us" << std::setw(12) << "total us"
+            << "\n";
+  for (auto const& evt : stats.events) {
+    if (evt.dispatches == 0) {
+      continue;
+    }
+    std::cout << std::left << std::setw(28) << evt.name << std::right
+              << std::setw(9) << evt.dispatches << std::setw(10)
+              << evt.prevented;
+    print_histogram(evt.dispatch_time);
+    std::cout << "  " << evt.emitted << " events";
+    if (evt.queue_allocations > 0) {
+      std::cout << ", " << evt.queue_allocations << " queue allocations";
+    }
+    std::cout << "\n";
+    for (auto const& handler : evt.handlers) {
+      std::string label =
+          std::format("  {}{} p{}",
+                      handler.owner.empty() ? "?" : handler.owner,
+                      handler.batch ? " batch" : "",
+                      handler.priority);
+
+      std::cout << std::left << std::setw(28) << label << std::right
+                << std::setw(9) << handler.time.count << std::setw(10)
+                << handler.prevented;
+      print_histogram(handler.time);
+      std::cout << "\n";
+    }
+  }
+}
+
 extern "C"
 {
 PLUGIN_EXPORT void* entry_point(Registry& r,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -33,7 +34,7 @@ private:
   void collision_system(Registry& r);
   void interaction_zone_system(Registry& r);
   void interaction_borders_system(Registry& r);
-  void on_collision(const CollisionEvent& c);
+  void on_collisions(std::span<CollisionEvent const> collisions);
 
   std::unique_ptr<ICollisionAlgorithm> _collision_algo;
 };
@@ -1,5 +1,6 @@
 #include <cctype>
 #include <iostream>
+#include <span>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -12,7 +13,7 @@
 #include "ecs/EventManager.hpp"
 #include "ecs/InitComponent.hpp"
 #include "ecs/Registry.hpp"
-#include "ecs/zipper/ZipperIndex.hpp"
+#include "ecs/zipper/Query.hpp"
 #include "libs/Vector2D.hpp"
 #include "plugin/APlugin.hpp"
 #include "plugin/EntityLoader.hpp"
@@ -59,7 +60,7 @@ Collision::Collision(Registry& r, EventManager& em, EntityLoader& l)
   _registry.get().add_system(
       [this](Registry& r) { this->interaction_borders_system(r); }, 3);
 
-  SUBSCRIBE_EVENT(CollisionEvent, { this->on_collision(event); })
+  SUBSCRIBE_EVENT_BATCH(CollisionEvent, { this->on_collisions(events); })
 }
 
 void Collision::set_algorithm(std::unique_ptr<ICollisionAlgorithm> algo)
@@ -145,19 +146,27 @@ void Collision::collision_system(Registry& r)
   }
 
   std::vector<ICollisionAlgorithm::CollisionEntity> entities;
+  auto const& offsets = r.get_components<Offset>();
+  auto query = r.query<Position const, Collidable const>();
+
+  entities.reserve(query.count());
+  query.each(
+      [&entities, &offsets](Ecs::Entity i,
+                            Position const& position,
+                            Collidable const& collidable)
+      {
+        if (!collidable.is_active) {
+          return;
+        }
+        Vector2D world = world_position(offsets, i, position);
 
-  for (auto&& [i, position, collidable] : ZipperIndex<Position, Collidable>(r))
-  {
-    if (!collidable.is_active) {
-      continue;
-    }
-    entities.push_back(ICollisionAlgorithm::CollisionEntity {
-        .entity_id = i,
-        .bounds = Rect {.x = position.pos.x,
-                        .y = position.pos.y,
-                        .width = collidable.size.x,
-                        .height = collidable.size.y}});
-  }
+        entities.push_back(ICollisionAlgorithm::CollisionEntity {
+            .entity_id = i,
+            .bounds = Rect {.x = world.x,
+                            .y = world.y,
+                            .width = collidable.size.x,
+                            .height = collidable.size.y}});
+      });
 
   _collision_algo->update(entities);
   auto collisions = _collision_algo->detect_collisions(entities);
@@ -166,9 +175,10 @@ void Collision::collision_system(Registry& r)
     std::size_t entity_a = collision.entity_a;
     std::size_t entity_b = collision.entity_b;
 
-    this->_event_manager.get().emit<CollisionEvent>(entity_a, entity_b);
-    this->_event_manager.get().emit<CollisionEvent>(entity_b, entity_a);
+    this->_event_manager.get().enqueue<CollisionEvent>(entity_a, entity_b);
+    this->_event_manager.get().enqueue<CollisionEvent>(entity_b, entity_a);
   }
+  this->_event_manager.get().dispatch_queued<CollisionEvent>();
 }
 
 void Collision::interaction_borders_system(Registry& r)
@@ -178,54 +188,63 @@ void Collision::interaction_borders_system(Registry& r)
   }
 
   auto const& positions = r.get_components<Position>();
-  for (auto&& [i, position, zone] :
-       ZipperIndex<Position, InteractionBorders>(r))
-  {
-    if (!zone.enabled) {
-      continue;
-    }
-
-    Rect range {.x = position.pos.x,
-                .y = position.pos.y,
-                .width = zone.radius * 2,
-                .height = zone.radius * 2};
-
-    std::vector<ICollisionAlgorithm::CollisionEntity> candidates =
-        _collision_algo->detect_range_collisions(range);
-    std::vector<Ecs::Entity> detected_entities;
-    detected_entities.reserve(candidates.size());
-
-    for (const auto& candidate : candidates) {
-      if (candidate.entity_id == i) {
-        continue;
-      }
-      Vector2D distance = positions[candidate.entity_id]->pos - position.pos;
-
-      if (distance.length() <= zone.radius) {
-        detected_entities.push_back(candidate.entity_id);
-      }
-    }
-    std::vector<Ecs::Entity> entity_bfr =
-        std::vector(zone.in_zone.begin(), zone.in_zone.end());
-    std::vector<Ecs::Entity> entity_now = detected_entities;
-    for (auto eb : entity_bfr) {
-      for (auto en : entity_now) {
-        if (eb == en) {
-          entity_bfr.erase(std::find(entity_now.begin(), entity_now.end(), eb));
-          entity_now.erase(std::find(entity_now.begin(), entity_now.end(), en));
-          break;
+  auto const& offsets = r.get_components<Offset>();
+  r.query<Position const, InteractionBorders>().each(
+      [this, &positions, &offsets](Ecs::Entity i,
+                                   Position const& position,
+                                   InteractionBorders& zone)
+      {
+        if (!zone.enabled) {
+          return;
         }
-      }
-    }
-    for (auto entity : entity_bfr) {
-      this->_event_manager.get().emit<LeftZone>(i, entity);
-    }
-    for (auto entity : entity_now) {
-      this->_event_manager.get().emit<EnteredZone>(i, entity);
-    }
-    zone.in_zone = std::unordered_set<Ecs::Entity>(
-        detected_entities.begin(), detected_entities.end());
-  }
+        Vector2D center = world_position(offsets, i, position);
+
+        Rect range {.x = center.x,
+                    .y = center.y,
+                    .width = zone.radius * 2,
+                    .height = zone.radius * 2};
+
+        std::vector<ICollisionAlgorithm::CollisionEntity> candidates =
+            _collision_algo->detect_range_collisions(range);
+        std::vector<Ecs::Entity> detected_entities;
+        detected_entities.reserve(candidates.size());
+
+        for (const auto& candidate : candidates) {
+          if (candidate.entity_id == i) {
+            continue;
+          }
+          Vector2D distance = world_position(offsets,
+                                             candidate.entity_id,
+                                             *positions[candidate.entity_id])
+              - center;
+
+          if (distance.length() <= zone.radius) {
+            detected_entities.push_back(candidate.entity_id);
+          }
+        }
+        std::vector<Ecs::Entity> entity_bfr =
+            std::vector(zone.in_zone.begin(), zone.in_zone.end());
+        std::vector<Ecs::Entity> entity_now = detected_entities;
+        for (auto eb : entity_bfr) {
+          for (auto en : entity_now) {
+            if (eb == en) {
+              entity_bfr.erase(
+                  std::find(entity_now.begin(), entity_now.end(), eb));
+              entity_now.erase(
+                  std::find(entity_now.begin(), entity_now.end(), en));
+              break;
+            }
+          }
+        }
+        for (auto entity : entity_bfr) {
+          this->_event_manager.get().emit<LeftZone>(i, entity);
+        }
+        for (auto entity : entity_now) {
+          this->_event_manager.get().emit<EnteredZone>(i, entity);
+        }
+        zone.in_zone = std::unordered_set<Ecs::Entity>(
+            detected_entities.begin(), detected_entities.end());
+      });
 }
 
 void Collision::interaction_zone_system(Registry& r)
@@ -235,140 +254,155 @@ void Collision::interaction_zone_system(Registry& r)
   }
 
   auto const& positions = r.get_components<Position>();
-  for (auto&& [i, position, zone] : ZipperIndex<Position, InteractionZone>(r)) {
-    if (!zone.enabled) {
-      continue;
-    }
-
-    Rect range {.x = position.pos.x,
-                .y = position.pos.y,
-                .width = zone.radius * 2,
-                .height = zone.radius * 2};
-
-    std::vector<ICollisionAlgorithm::CollisionEntity> candidates =
-        _collision_algo->detect_range_collisions(range);
-    std::vector<Ecs::Entity> detected_entities;
-    detected_entities.reserve(candidates.size());
-
-    for (const auto& candidate : candidates) {
-      if (candidate.entity_id == i) {
-        continue;
-      }
-      Vector2D distance = positions[candidate.entity_id]->pos - position.pos;
-
-      if (distance.length() <= zone.radius) {
-        detected_entities.push_back(candidate.entity_id);
-      }
-    }
-    if (!detected_entities.empty()) {
-      this->_event_manager.get().emit<InteractionZoneEvent>(
-          i, zone.radius, detected_entities);
-    }
-  }
+  auto const& offsets = r.get_components<Offset>();
+  r.query<Position const, InteractionZone const>().each(
+      [this, &positions, &offsets](Ecs::Entity i,
+                                   Position const& position,
+                                   InteractionZone const& zone)
+      {
+        if (!zone.enabled) {
+          return;
+        }
+        Vector2D center = world_position(offsets, i, position);
+
+        Rect range {.x = center.x,
+                    .y = center.y,
+                    .width = zone.radius * 2,
+                    .height = zone.radius * 2};
+
+        std::vector<ICollisionAlgorithm::CollisionEntity> candidates =
+            _collision_algo->detect_range_collisions(range);
+        std::vector<Ecs::Entity> detected_entities;
+        detected_entities.reserve(candidates.size());
+
+        for (const auto& candidate : candidates) {
+          if (candidate.entity_id == i) {
+            continue;
+          }
+          Vector2D distance = world_position(offsets,
+                                             candidate.entity_id,
+                                             *positions[candidate.entity_id])
+              - center;
+
+          if (distance.length() <= zone.radius) {
+            detected_entities.push_back(candidate.entity_id);
+          }
+        }
+        if (!detected_entities.empty()) {
+          this->_event_manager.get().emit<InteractionZoneEvent>(
+              i, zone.radius, detected_entities);
+        }
+      });
 }
 
-void Collision::on_collision(const CollisionEvent& c)
+void Collision::on_collisions(std::span<CollisionEvent const> collisions)
 {
   auto& directions = this->_registry.get().get_components<Direction>();
   auto& speeds = this->_registry.get().get_components<Speed>();
   auto& positions = this->_registry.get().get_components<Position>();
-  auto& raycasting_cameras = this->_registry.get().get_components<RaycastingCamera>();
+  auto& raycasting_cameras =
+      this->_registry.get().get_components<RaycastingCamera>();
   auto const& teams = this->_registry.get().get_components<Team>();
   auto const& collidables = this->_registry.get().get_components<Collidable>();
+  double dt = this->_registry.get().clock().delta_seconds();
 
-  if (this->_registry.get().has_component<Team>(c.a)
-      && this->_registry.get().has_component<Team>(c.b)
-      && teams[c.a]->name == teams[c.b]->name)
-  {
-    return;
-  }
-
-  if (!this->_registry.get().has_component<Collidable>(c.a)
-      || !this->_registry.get().has_component<Collidable>(c.b)
-      || !this->_registry.get().has_component<Position>(c.a)
-      || !this->_registry.get().has_component<Position>(c.b))
-  {
-    return;
-  }
+  for (auto const& c : collisions) {
+    if (this->_registry.get().has_component<Team>(c.a)
+        && this->_registry.get().has_component<Team>(c.b)
+        && teams[c.a]->name == teams[c.b]->name)
+    {
+      continue;
+    }
 
-  CollisionType type_a = collidables[c.a]->collision_type;
-  CollisionType type_b = collidables[c.b]->collision_type;
+    if (!this->_registry.get().has_component<Collidable>(c.a)
+        || !this->_registry.get().has_component<Collidable>(c.b)
+        || !this->_registry.get().has_component<Position>(c.a)
+        || !this->_registry.get().has_component<Position>(c.b))
+    {
+      continue;
+    }
 
-  if ((type_a != CollisionType::Solid && type_a != CollisionType::Push
-       && type_a != CollisionType::Bounce)
-      || (type_b != CollisionType::Solid && type_b != CollisionType::Push
-          && type_b != CollisionType::Bounce))
-  {
-    return;
-  }
-  double dt = this->_registry.get().clock().delta_seconds();
+    CollisionType type_a = collidables[c.a]->collision_type;
+    CollisionType type_b = collidables[c.b]->collision_type;
 
-  if (this->_registry.get().has_component<Direction>(c.a)
-      && this->_registry.get().has_component<Speed>(c.a))
-  {
-    Vector2D real_direction = directions[c.a]->direction;
-    if (this->_registry.get().has_component<RaycastingCamera>(c.a)) {
-      double cam_angle = raycasting_cameras[c.a]->angle;
-      real_direction.rotate_radians(cam_angle);
+    if ((type_a != CollisionType::Solid && type_a != CollisionType::Push
+         && type_a != CollisionType::Bounce)
+        || (type_b != CollisionType::Solid && type_b != CollisionType::Push
+            && type_b != CollisionType::Bounce))
+    {
+      continue;
     }
-    Vector2D movement =
-        (real_direction).normalize() * speeds[c.a]->speed * dt;
-    Vector2D collision_normal =
-        (positions[c.a]->pos - positions[c.b]->pos).normalize();
-
-    if (this->_registry.get().has_component<Direction>(c.b)
-        && this->_registry.get().has_component<Speed>(c.b)
-        && type_a == CollisionType::Push)
+
+    if (this->_registry.get().has_component<Direction>(c.a)
+        && this->_registry.get().has_component<Speed>(c.a))
     {
-      positions[c.a]->pos -= movement;
-      positions[c.b]->pos += movement;
-      this->_event_manager.get().emit<ComponentBuilder>(
-          c.b,
-          this->_registry.get().get_component_key<Position>(),
-          positions[c.b]->to_bytes());
-    } else if (type_a == CollisionType::Solid) {
-      double overlap_x =
-          ((collidables[c.a]->size.x + collidables[c.b]->size.x) / 2.0)
-          - std::abs(positions[c.a]->pos.x - positions[c.b]->pos.x);
-      double overlapY =
-          ((collidables[c.a]->size.y + collidables[c.b]->size.y) / 2.0)
-          - std::abs(positions[c.a]->pos.y - positions[c.b]->pos.y);
-
-      if (overlap_x > 0 && overlapY > 0) {
-        Vector2D clean_normal(0, 0);
-        double min_overlap = 0;
-        if (overlap_x < overlapY) {
-          clean_normal = {
-              (positions[c.a]->pos.x > positions[c.b]->pos.x) ? 1.0 : -1.0, 0};
-          min_overlap = overlap_x;
-        } else {
-          clean_normal = {
-              0, (positions[c.a]->pos.y > positions[c.b]->pos.y) ? 1.0 : -1.0};
-          min_overlap = overlapY;
-        }
-        double dot = movement.dot(clean_normal);
-        if (dot < -0.0001) {
-          Vector2D slide = movement - clean_normal * dot;
-          positions[c.a]->pos = (positions[c.a]->pos - movement) + slide;
+      Vector2D real_direction = directions[c.a]->direction;
+      if (this->_registry.get().has_component<RaycastingCamera>(c.a)) {
+        double cam_angle = raycasting_cameras[c.a]->angle;
+        real_direction.rotate_radians(cam_angle);
+      }
+      Vector2D movement =
+          (real_direction).normalize() * speeds[c.a]->speed * dt;
+      Vector2D collision_normal =
+          (positions[c.a]->pos - positions[c.b]->pos).normalize();
+
+      if (this->_registry.get().has_component<Direction>(c.b)
+          && this->_registry.get().has_component<Speed>(c.b)
+          && type_a == CollisionType::Push)
+      {
+        positions.modify(c.a)->pos -= movement;
+        positions.modify(c.b)->pos += movement;
+        this->_event_manager.get().emit<ComponentBuilder>(
+            c.b,
+            this->_registry.get().get_component_key<Position>(),
+            positions[c.b]->to_bytes());
+      } else if (type_a == CollisionType::Solid) {
+        double overlap_x =
+            ((collidables[c.a]->size.x + collidables[c.b]->size.x) / 2.0)
+            - std::abs(positions[c.a]->pos.x - positions[c.b]->pos.x);
+        double overlapY =
+            ((collidables[c.a]->size.y + collidables[c.b]->size.y) / 2.0)
+            - std::abs(positions[c.a]->pos.y - positions[c.b]->pos.y);
+
+        if (overlap_x > 0 && overlapY > 0) {
+          Vector2D clean_normal(0, 0);
+          double min_overlap = 0;
+          if (overlap_x < overlapY) {
+            clean_normal = {
+                (positions[c.a]->pos.x > positions[c.b]->pos.x) ? 1.0 : -1.0,
+                0};
+            min_overlap = overlap_x;
+          } else {
+            clean_normal = {
+                0,
+                (positions[c.a]->pos.y > positions[c.b]->pos.y) ? 1.0 : -1.0};
+            min_overlap = overlapY;
+          }
+          double dot = movement.dot(clean_normal);
+          if (dot < -0.0001) {
+            Vector2D slide = movement - clean_normal * dot;
+            positions.modify(c.a)->pos =
+                (positions[c.a]->pos - movement) + slide;
+          }
+          double correction_amount = std::max(min_overlap - 0.1, 0.0);
+          positions.modify(c.a)->pos += clean_normal * correction_amount;
         }
-        double correction_amount = std::max(min_overlap - 0.1, 0.0);
-        positions[c.a]->pos += clean_normal * correction_amount;
+      } else if (type_a == CollisionType::Bounce) {
+        double dot_product = directions[c.a]->direction.dot(collision_normal);
+        Vector2D reflected_direction = directions[c.a]->direction
+            - (collision_normal * (2.0 * dot_product));
+
+        directions[c.a]->direction = reflected_direction.normalize();
+        positions.modify(c.a)->pos += collision_normal * 0.01;
+      } else {
+        positions.modify(c.a)->pos -= movement;
       }
-    } else if (type_a == CollisionType::Bounce) {
-      double dot_product = directions[c.a]->direction.dot(collision_normal);
-      Vector2D reflected_direction =
-          directions[c.a]->direction - (collision_normal * (2.0 * dot_product));
-
-      directions[c.a]->direction = reflected_direction.normalize();
-      positions[c.a]->pos += collision_normal * 0.01;
-    } else {
-      positions[c.a]->pos -= movement;
-    }
 
-    this->_event_manager.get().emit<ComponentBuilder>(
-        c.a,
-        this->_registry.get().get_component_key<Position>(),
-        positions[c.a]->to_bytes());
+      this->_event_manager.get().emit<ComponentBuilder>(
+          c.a,
+          this->_registry.get().get_component_key<Position>(),
+          positions[c.a]->to_bytes());
+    }
   }
 }
 
@@ -7,6 +7,7 @@
 #include "Controller.hpp"
 
 #include "Json/JsonParser.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EmitEvent.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/Registry.hpp"
@@ -291,6 +292,35 @@ void Controller::init_controller(Ecs::Entity const& entity,
   std::cout << "CREATED COMPONENT Controllable for Entity: " << entity << "\n";
 }
 
+namespace
+{
+/**
+ * @brief Emits the event bound to a key, looked up when applied
+ *
+ * Keeps the recorded command to two integers: the binding parameters are
+ * read in place instead of copied once per controllable entity.
+ */
+struct EmitBinding
+{
+  void operator()(Registry& r, EventManager& em) const
+  {
+    auto const& c = r.get_components<Controllable>()[entity];
+
+    if (!c) {
+      return;
+    }
+    auto it = c->event_map.find(key_map);
+    if (it == c->event_map.end()) {
+      return;
+    }
+    emit_event(em, r, it->second.first.first, it->second.second, entity);
+  }
+
+  Ecs::Entity entity;
+  std::uint16_t key_map;
+};
+}  // namespace
+
 void Controller::handle_key_change(Key key, bool is_pressed)
 {
   this->_key_states[key] = is_pressed;
@@ -298,28 +328,18 @@ void Controller::handle_key_change(Key key, bool is_pressed)
   std::uint16_t key_map =
       (static_cast<std::uint32_t>(key) << 8) + static_cast<int>(is_pressed);
 
-  std::vector<std::function<void()>> to_emit;
-  for (auto&& [e, c] : ZipperIndex<Controllable>(this->_registry.get())) {
+  CommandBuffer to_emit;
+  for (auto&& [e, c] :
+       ZipperIndex<Controllable const>(this->_registry.get()))
+  {
     if (!this->_registry.get().is_in_main_scene(e)
         || !c.event_map.contains(key_map))
     {
       continue;
     }
-    auto const& event = c.event_map.at(key_map);
-
-    to_emit.emplace_back(
-        [this, &event, e]()
-        {
-          emit_event(this->_event_manager.get(),
-                     this->_registry.get(),
-                     event.first.first,
-                     event.second,
-                     e);
-        });
-  }
-  for (auto const& it : to_emit) {
-    it();
+    to_emit.call(EmitBinding {e, key_map});
   }
+  to_emit.apply(this->_registry.get(), this->_event_manager.get());
 };
 
 bool Controller::is_key_active(Key target) const
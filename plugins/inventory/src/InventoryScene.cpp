@@ -78,7 +78,8 @@ void InventoryPlugin::update_ath_scenes()
   if (this->_active_ath.empty()) {
     return;
   }
-  for (auto&& [e, team, text] : ZipperIndex<Team, Text>(this->_registry.get()))
+  for (auto&& [e, team, text] :
+       ZipperIndex<Team const, Text>(this->_registry.get()))
   {
     if (!team.name.starts_with("__inventory_ath__")) {
       continue;
@@ -114,7 +115,9 @@ void InventoryPlugin::delete_ath_scene(GenerateInventoryScene const& event)
   if (!this->_active_ath.contains(event.entity)) {
     return;
   }
-  for (auto const&& [e, team] : ZipperIndex<Team>(this->_registry.get())) {
+  for (auto const&& [e, team] :
+       ZipperIndex<Team const>(this->_registry.get()))
+  {
     if (team.name.starts_with(
             std::format("__inventory_ath__:{}", event.entity)))
     {
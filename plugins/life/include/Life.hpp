@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -31,7 +32,7 @@ private:
 
   void update_cooldowns(Registry& reg);
 
-  void on_collision(const CollisionEvent& event);
+  void on_collisions(std::span<CollisionEvent const> collisions);
   void on_damage(const DamageEvent& event);
   void on_heal(const HealEvent& event);
 };
@@ -4,6 +4,7 @@
 #include <functional>
 #include <iostream>
 #include <optional>
+#include <span>
 
 #include "Life.hpp"
 
@@ -46,12 +47,13 @@ Life::Life(Registry& r, EventManager& em, EntityLoader& l)
   REGISTER_COMPONENT(Heal)
   REGISTER_COMPONENT(Team)
 
-  this->_registry.get().add_system(
-      [this](Registry& r) { this->update_cooldowns(r); }, 2);
+  this->_registry.get().add_concurrent_system<Health>(
+      [this](Registry& r, SparseArray<Health>&) { this->update_cooldowns(r); },
+      2);
 
   SUBSCRIBE_EVENT(DamageEvent, { this->on_damage(event); })
   SUBSCRIBE_EVENT(HealEvent, { this->on_heal(event); })
-  SUBSCRIBE_EVENT(CollisionEvent, { this->on_collision(event); })
+  SUBSCRIBE_EVENT_BATCH(CollisionEvent, { this->on_collisions(events); })
 }
 
 void Life::init_health(Ecs::Entity entity, JsonObject const& obj)
@@ -151,26 +153,29 @@ void Life::heal_entity(const CollisionEvent& event,
   }
 }
 
-void Life::on_collision(const CollisionEvent& event)
+void Life::on_collisions(std::span<CollisionEvent const> collisions)
 {
   auto& healths = this->_registry.get().get_components<Health>();
-  auto& teams = this->_registry.get().get_components<Team>();
-
-  if (!this->_registry.get().has_component<Health>(event.a)
-      || !this->_registry.get().has_component<Team>(event.a)
-      || !this->_registry.get().has_component<Team>(event.b))
-  {
-    return;
-  }
+  auto const& teams = this->_registry.get().get_components<Team>();
+  auto const& damages = this->_registry.get().get_components<Damage>();
+  auto const& heals = this->_registry.get().get_components<Heal>();
+
+  for (auto const& event : collisions) {
+    if (!healths.contains(event.a) || !teams.contains(event.a)
+        || !teams.contains(event.b))
+    {
+      continue;
+    }
 
-  if (this->_registry.get().has_component<Damage>(event.b)
-      && teams[event.a]->name != teams[event.b]->name)
-  {
-    damage_entity(event, healths);
-  } else if (this->_registry.get().has_component<Heal>(event.b)
-             && teams[event.a]->name == teams[event.b]->name)
-  {
-    heal_entity(event, healths);
+    if (damages.contains(event.b)
+        && teams[event.a]->name != teams[event.b]->name)
+    {
+      damage_entity(event, healths);
+    } else if (heals.contains(event.b)
+               && teams[event.a]->name == teams[event.b]->name)
+    {
+      heal_entity(event, healths);
+    }
   }
 }
 
@@ -228,17 +233,15 @@ void Life::update_cooldowns(Registry& reg)
 {
   double dt = reg.clock().delta_seconds();
 
-  for (auto&& [i, health] : ZipperIndex<Health>(reg)) {
-    if (!reg.is_entity_dying(i)) {
-      health.damage_delta += dt;
-      health.heal_delta += dt;
-
-      // this->_registry.get().emit<ComponentBuilder>(
-      //     i,
-      //     this->_registry.get().get_component_key<Health>(),
-      //     health.to_bytes());
-    }
-  }
+  // The Zipper skips entities of paused and inactive scenes
+  ZipperIndex<Health>(reg).par_each(
+      [&reg, dt](std::size_t i, Health& health)
+      {
+        if (!reg.is_entity_dying(i)) {
+          health.damage_delta += dt;
+          health.heal_delta += dt;
+        }
+      });
 }
 
 extern "C"
@@ -5,6 +5,7 @@
 
 #include "Json/JsonParser.hpp"
 #include "NetworkShared.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/zipper/ZipperIndex.hpp"
 #include "libs/Vector2D.hpp"
@@ -119,7 +120,10 @@ void Mob::on_interaction_zone(const InteractionZoneEvent& event)
 void Mob::parasite_system(Registry& r)
 {
   for (auto&& [i, parasite, pos, speed, direction] :
-       ZipperIndex<Parasite, Position, Speed, Direction>(r))
+       ZipperIndex<Parasite const,
+                   Position const,
+                   Speed const,
+                   Direction const>(r))
   {
     if (r.is_entity_dying(i)) {
       continue;
@@ -146,9 +150,7 @@ void Mob::parasite_system(Registry& r)
 
 void Mob::spawner_system(Registry& r)
 {
-  std::vector<std::function<void()>> event_to_emit;
-
-  for (auto&& [i, spawner, pos] : ZipperIndex<Spawner, Position>(r)) {
+  for (auto&& [i, spawner, pos] : ZipperIndex<Spawner, Position const>(r)) {
     if (r.is_entity_dying(i)) {
       continue;
     }
@@ -166,37 +168,19 @@ void Mob::spawner_system(Registry& r)
       if (spawner.current_spawns >= spawner.max_spawns) {
         spawner.active = false;
       }
-      event_to_emit.emplace_back(
-          [this,
-           i = i,
-           spawner_bytes = spawner.to_bytes(),
-           entity_template = spawner.entity_template,
-           pos_bytes = pos.to_bytes()]()
-          {
-            this->_event_manager.get().emit<ComponentBuilder>(
-                i,
-                this->_registry.get().get_component_key<Spawner>(),
-                spawner_bytes);
-            LoadEntityTemplate::Additional additional = {
-                {this->_registry.get().get_component_key<Position>(),
-                 pos_bytes}};
-
-            if (this->_registry.get().has_component<Scene>(i)) {
-              additional.push_back(
-                  {this->_registry.get().get_component_key<Scene>(),
-                   this->_registry.get()
-                       .get_components<Scene>()[i]
-                       .value()
-                       .to_bytes()});
-            }
-            this->_event_manager.get().emit<LoadEntityTemplate>(entity_template,
-                                                                additional);
-          });
+      LoadEntityTemplate::Additional additional = {
+          {r.get_component_key<Position>(), pos.to_bytes()}};
+
+      if (r.has_component<Scene>(i)) {
+        additional.push_back({r.get_component_key<Scene>(),
+                              r.get_components<Scene>()[i].value().to_bytes()});
+      }
+      r.commands().emit<ComponentBuilder>(
+          i, r.get_component_key<Spawner>(), spawner.to_bytes());
+      r.commands().emit<LoadEntityTemplate>(spawner.entity_template,
+                                            std::move(additional));
     }
   }
-  for (auto const& fn : event_to_emit) {
-    fn();
-  }
 }
 
 extern "C"
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <vector>
+
 #include "Json/JsonParser.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/Registry.hpp"
 #include "plugin/APlugin.hpp"
 #include "plugin/EntityLoader.hpp"
+#include "plugin/TransformHierarchy.hpp"
+#include "plugin/components/BasicMap.hpp"
 #include "plugin/components/Position.hpp"
+#include "plugin/components/RaycastingCamera.hpp"
 #include "plugin/events/CollisionEvent.hpp"
 
 class Moving : public APlugin
@@ -16,14 +21,19 @@ public:
 private:
   void init_pos(Ecs::Entity const& entity, JsonObject& obj);
   void init_off(Ecs::Entity const& entity, JsonObject& obj);
+  void init_parent(Ecs::Entity const& entity, JsonObject& obj);
   void init_direction(Ecs::Entity const& entity, JsonObject& obj);
   void init_speed(Ecs::Entity const& entity, JsonObject& obj);
   void init_facing(Ecs::Entity const& entity, JsonObject& obj);
 
   void init_id(Ecs::Entity const& entity, JsonObject& obj);
-  void moving_system(Registry&);
+  void moving_system(Registry& reg,
+                     SparseArray<RaycastingCamera> const& raycasting_cameras,
+                     SparseArray<BasicMap> const& basic_maps);
 
   void on_set_direction(Registry& r, const SetDirectionEvent& event);
-  void add_offset(Registry& r);
-  void remove_offset(Registry& r);
+  void transform_system(Registry& r);
+
+  TransformHierarchy _transforms;
+  std::vector<Ecs::Entity> _moved;  ///< Children placed this frame
 };
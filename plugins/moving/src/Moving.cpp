@@ -9,9 +9,11 @@
 #include "EntityExpose.hpp"
 #include "Json/JsonParser.hpp"
 #include "NetworkShared.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/InitComponent.hpp"
 #include "ecs/Registry.hpp"
+#include "ecs/zipper/Group.hpp"
 #include "ecs/zipper/ZipperIndex.hpp"
 #include "libs/Vector2D.hpp"
 #include "plugin/APlugin.hpp"
@@ -34,6 +36,7 @@ Moving::Moving(Registry& r, EventManager& em, EntityLoader& l)
               {"raycasting"},
               {COMP_INIT(Position, Position, init_pos),
                COMP_INIT(Offset, Offset, init_off),
+               COMP_INIT(Parent, Parent, init_parent),
                COMP_INIT(Direction, Direction, init_direction),
                COMP_INIT(Speed, Speed, init_speed),
                COMP_INIT(Facing, Facing, init_facing),
@@ -41,16 +44,27 @@ Moving::Moving(Registry& r, EventManager& em, EntityLoader& l)
 {
   REGISTER_COMPONENT(Position)
   REGISTER_COMPONENT(Offset)
+  REGISTER_COMPONENT(Parent)
   REGISTER_COMPONENT(Direction)
   REGISTER_COMPONENT(Speed)
   REGISTER_COMPONENT(Facing)
   REGISTER_COMPONENT(IdStorage)
-  this->_registry.get().add_system([this](Registry& r) { this->add_offset(r); },
-                                   1000);
+  this->_registry.get()
+      .add_concurrent_system<Position,
+                             Direction const,
+                             Speed const,
+                             RaycastingCamera const,
+                             BasicMap const>(
+          [this](Registry& r,
+                 SparseArray<Position>&,
+                 SparseArray<Direction> const&,
+                 SparseArray<Speed> const&,
+                 SparseArray<RaycastingCamera> const& cameras,
+                 SparseArray<BasicMap> const& maps)
+          { this->moving_system(r, cameras, maps); },
+          4);
   this->_registry.get().add_system(
-      [this](Registry& r) { this->moving_system(r); }, 4);
-  this->_registry.get().add_system(
-      [this](Registry& r) { this->remove_offset(r); }, 0);
+      [this](Registry& r) { this->transform_system(r); }, 4);
 
   SUBSCRIBE_EVENT(UpdateDirection, {
     if (!this->_registry.get().has_component<Direction>(event.entity)) {
@@ -93,96 +107,93 @@ void Moving::on_set_direction(Registry& r, const SetDirectionEvent& event)
   direction->direction.y = std::clamp(event.direction.y, -1.0, 1.0);
 }
 
-void Moving::moving_system(Registry& reg)
+void Moving::moving_system(
+    Registry& reg,
+    SparseArray<RaycastingCamera> const& raycasting_cameras,
+    SparseArray<BasicMap> const& basic_maps)
 {
   double dt = reg.clock().delta_seconds();
 
-  auto& raycasting_cameras = reg.get_components<RaycastingCamera>();
-  auto& basic_maps = reg.get_components<BasicMap>();
-
-  for (auto&& [index, position, direction, speed] :
-       ZipperIndex<Position, Direction, Speed>(reg))
-  {
-    Vector2D real_direction = direction.direction;
-    bool use_grid_collision = false;
-
-    if (index < raycasting_cameras.size()
-        && raycasting_cameras[index].has_value())
-    {
-      double cam_angle = raycasting_cameras[index]->angle;
-      real_direction.rotate_radians(cam_angle);
-      use_grid_collision = true;
-    }
-
-    Vector2D movement = real_direction.normalize() * speed.speed * dt;
-
-    if (use_grid_collision && movement.length() > 0) {
-      constexpr double player_radius = 0.2;
-      Vector2D new_pos = position.pos + movement;
-
-      for (auto const& map_opt : basic_maps) {
-        if (!map_opt.has_value()) {
-          continue;
-        }
-        auto const& map = map_opt.value();
-
-        if (position.pos.x < 0 || position.pos.x >= map.size.x
-            || position.pos.y < 0 || position.pos.y >= map.size.y)
+  reg.group<Position, Direction const, Speed const>().par_each(
+      [&](std::size_t index,
+          Position& position,
+          Direction const& direction,
+          Speed const& speed)
+      {
+        Vector2D real_direction = direction.direction;
+        bool use_grid_collision = false;
+
+        if (index < raycasting_cameras.size()
+            && raycasting_cameras[index].has_value())
         {
-          continue;
+          double cam_angle = raycasting_cameras[index]->angle;
+          real_direction.rotate_radians(cam_angle);
+          use_grid_collision = true;
         }
 
-        int check_x = static_cast<int>(std::floor(
-            new_pos.x + (movement.x > 0 ? player_radius : -player_radius)));
-        int current_y = static_cast<int>(std::floor(position.pos.y));
-        if (check_x >= 0 && check_x < static_cast<int>(map.size.x)
-            && current_y >= 0 && current_y < static_cast<int>(map.size.y)
-            && map.data[current_y][check_x] != 0)
-        {
-          movement.x = 0;
+        Vector2D movement = real_direction.normalize() * speed.speed * dt;
+
+        if (use_grid_collision && movement.length() > 0) {
+          constexpr double player_radius = 0.2;
+          Vector2D new_pos = position.pos + movement;
+
+          for (auto const& map_opt : basic_maps) {
+            if (!map_opt.has_value()) {
+              continue;
+            }
+            auto const& map = map_opt.value();
+
+            if (position.pos.x < 0 || position.pos.x >= map.size.x
+                || position.pos.y < 0 || position.pos.y >= map.size.y)
+            {
+              continue;
+            }
+
+            int check_x = static_cast<int>(std::floor(
+                new_pos.x + (movement.x > 0 ? player_radius : -player_radius)));
+            int current_y = static_cast<int>(std::floor(position.pos.y));
+            if (check_x >= 0 && check_x < static_cast<int>(map.size.x)
+                && current_y >= 0 && current_y < static_cast<int>(map.size.y)
+                && map.data[current_y][check_x] != 0)
+            {
+              movement.x = 0;
+            }
+
+            int current_x = static_cast<int>(std::floor(position.pos.x));
+            int check_y = static_cast<int>(std::floor(
+                new_pos.y + (movement.y > 0 ? player_radius : -player_radius)));
+            if (current_x >= 0 && current_x < static_cast<int>(map.size.x)
+                && check_y >= 0 && check_y < static_cast<int>(map.size.y)
+                && map.data[check_y][current_x] != 0)
+            {
+              movement.y = 0;
+            }
+          }
         }
 
-        int current_x = static_cast<int>(std::floor(position.pos.x));
-        int check_y = static_cast<int>(std::floor(
-            new_pos.y + (movement.y > 0 ? player_radius : -player_radius)));
-        if (current_x >= 0 && current_x < static_cast<int>(map.size.x)
-            && check_y >= 0 && check_y < static_cast<int>(map.size.y)
-            && map.data[check_y][current_x] != 0)
-        {
-          movement.y = 0;
+        position.pos += movement;
+        if (movement.length() != 0) {
+          // Stored in the task's arena, serialized once the batch is over
+          reg.commands().call(
+              [index, position](Registry& r, EventManager& em)
+              {
+                em.emit<ComponentBuilder>(index,
+                                          r.get_component_key<Position>(),
+                                          position.to_bytes());
+              });
         }
-      }
-    }
-
-    position.pos += movement;
-    if (movement.length() != 0) {
-      this->_event_manager.get().emit<ComponentBuilder>(
-          index, reg.get_component_key<Position>(), position.to_bytes());
-    }
-  }
+      });
 }
 
-void Moving::add_offset(Registry& r)
+void Moving::transform_system(Registry& r)
 {
-  for (auto&& [e, pos, offset] : ZipperIndex<Position, Offset>(r)) {
-    if (!pos.applied_offset) {
-      pos.pos += offset.offset;
-      pos.applied_offset = true;
-    }
+  this->_moved.clear();
+  this->_transforms.update(r, this->_moved);
+  for (Ecs::Entity e : this->_moved) {
     this->_event_manager.get().emit<ComponentBuilder>(
-        e, r.get_component_key<Position>(), pos.to_bytes());
-  }
-}
-
-void Moving::remove_offset(Registry& r)
-{
-  for (auto&& [e, pos, off] : ZipperIndex<Position, Offset>(r)) {
-    if (pos.applied_offset) {
-      pos.pos -= off.offset;
-      pos.applied_offset = false;
-    }
-    this->_event_manager.get().emit<ComponentBuilder>(
-        e, r.get_component_key<Position>(), pos.to_bytes());
+        e,
+        r.get_component_key<Position>(),
+        r.get_components<Position>()[e]->to_bytes());
   }
 }
 
@@ -263,6 +274,28 @@ void Moving::init_off(Ecs::Entity const& entity, JsonObject& obj)
   }
 }
 
+void Moving::init_parent(Ecs::Entity const& entity, JsonObject& obj)
+{
+  auto parent = get_value<Parent, std::size_t>(
+      this->_registry.get(), obj, entity, "entity");
+
+  if (!parent) {
+    std::cerr << "Error loading Parent component: missing entity "
+                 "in JsonObject\n";
+    return;
+  }
+
+  auto& parent_opt = init_component<Parent>(this->_registry.get(),
+                                            this->_event_manager.get(),
+                                            entity,
+                                            parent.value());
+
+  if (!parent_opt.has_value()) {
+    std::cerr << "Error creating Parent component\n";
+    return;
+  }
+}
+
 void Moving::init_direction(Ecs::Entity const& entity, JsonObject& obj)
 {
   auto dir = get_value<Direction, Vector2D>(
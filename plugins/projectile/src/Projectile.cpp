@@ -2,6 +2,7 @@
 
 #include "Json/JsonParser.hpp"
 #include "NetworkShared.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/InitComponent.hpp"
 #include "ecs/Registry.hpp"
@@ -26,10 +27,11 @@ Projectile::Projectile(Registry& r, EventManager& em, EntityLoader& l)
   REGISTER_COMPONENT(Temporal)
   REGISTER_COMPONENT(Fragile)
 
-  this->_registry.get().add_system(
-      [this](Registry& r) { this->temporal_system(r); }, 2);
-  this->_registry.get().add_system([this](Registry& r)
-                                   { this->fragile_system(r); });
+  this->_registry.get().add_concurrent_system<Temporal>(
+      [this](Registry& r, SparseArray<Temporal>&) { this->temporal_system(r); },
+      2);
+  this->_registry.get().add_concurrent_system<Fragile>(
+      [this](Registry& r, SparseArray<Fragile>&) { this->fragile_system(r); });
 
   SUBSCRIBE_EVENT(CollisionEvent, { this->on_collision(event); })
 }
@@ -76,13 +78,11 @@ void Projectile::temporal_system(Registry& reg)
     if (!reg.is_entity_dying(i)) {
       temporal.elapsed += dt;
 
-      this->_event_manager.get().emit<ComponentBuilder>(
-          i,
-          this->_registry.get().get_component_key<Temporal>(),
-          temporal.to_bytes());
+      reg.commands().emit<ComponentBuilder>(
+          i, reg.get_component_key<Temporal>(), temporal.to_bytes());
 
       if (temporal.elapsed >= temporal.lifetime) {
-        this->_event_manager.get().emit<DeathEvent>(i, i);
+        reg.commands().emit<DeathEvent>(i, i);
       }
     }
   }
@@ -96,10 +96,8 @@ void Projectile::fragile_system(Registry& reg)
     if (!reg.is_entity_dying(i)) {
       fragile.fragile_delta += dt;
 
-      this->_event_manager.get().emit<ComponentBuilder>(
-          i,
-          this->_registry.get().get_component_key<Fragile>(),
-          fragile.to_bytes());
+      reg.commands().emit<ComponentBuilder>(
+          i, reg.get_component_key<Fragile>(), fragile.to_bytes());
     }
   }
 }
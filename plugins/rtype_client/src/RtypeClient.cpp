@@ -28,7 +28,7 @@ RtypeClient::RtypeClient(Registry& r,
     : BaseClient("rtype_client", "r-type", r, em, l, config)
 {
   SUBSCRIBE_EVENT(PlayerCreation, {
-    auto zipper = ZipperIndex<Controllable>(this->_registry.get());
+    auto zipper = ZipperIndex<Controllable const>(this->_registry.get());
 
     if (zipper.begin() != zipper.end()) {
       std::size_t index = std::get<0>(*zipper.begin());
@@ -101,7 +101,7 @@ void RtypeClient::alert(std::string const& message)
   this->_event_manager.get().emit<SceneChangeEvent>(
       "alert", "connected", false, true);
   for (auto [e, text, scene, team] :
-       ZipperIndex<Text, Scene, Team>(this->_registry.get()))
+       ZipperIndex<Text, Scene const, Team const>(this->_registry.get()))
   {
     if (scene.scene_name != "alert" || team.name != "message") {
       continue;
@@ -58,7 +58,8 @@ RtypeSingle::RtypeSingle(Registry& r,
 
     // Search without scene filtering to find ALL Controllable entities
     auto zipper =
-        ZipperIndex<Controllable>(this->_registry.get(), SceneState::DISABLED);
+        ZipperIndex<Controllable const>(this->_registry.get(),
+                                        SceneState::DISABLED);
 
     if (zipper.begin() != zipper.end()) {
       std::size_t controllable_entity = std::get<0>(*zipper.begin());
@@ -13,7 +13,8 @@
 
 void SFMLRenderer::background_system(Registry& r)
 {
-  for (const auto&& [draw, background] : Zipper<Drawable, Background>(r)) {
+  for (const auto&& [draw, background] : Zipper<Drawable const, Background>(r))
+  {
     if (!draw.enabled) {
       continue;
     }
@@ -297,7 +297,7 @@ void SFMLRenderer::render_basic_map(
   double fov = 0;
   int nb_rays = 0;
 
-  for (auto&& [pos, cam] : Zipper<Position, RaycastingCamera>(r)) {
+  for (auto&& [pos, cam] : Zipper<Position const, RaycastingCamera const>(r)) {
     cam_angle = cam.angle;
     cam_pos = pos.pos;
     fov = cam.fov;
@@ -316,7 +316,7 @@ void SFMLRenderer::render_basic_map(
   this->_rectangle.setPosition(
       {0.0f, static_cast<float>(window_size.y) / 2.0f});
   this->_window.draw(this->_rectangle);
-  for (auto&& [draw, basic_map] : Zipper<Drawable, BasicMap>(r)) {
+  for (auto&& [draw, basic_map] : Zipper<Drawable const, BasicMap const>(r)) {
     if (!draw.enabled) {
       continue;
     }
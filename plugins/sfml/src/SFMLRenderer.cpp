@@ -340,18 +340,22 @@ void SFMLRenderer::render_sprites(Registry& r,
                                   const sf::Vector2f& view_size,
                                   const sf::Vector2f& view_pos)
 {
-  for (auto&& [pos, draw, spr] : Zipper<Position, Drawable, Sprite>(r)) {
+  auto const& offsets = r.get_components<Offset>();
+
+  for (auto&& [e, pos, draw, spr] :
+       ZipperIndex<Position const, Drawable, Sprite const>(r))
+  {
     if (!draw.enabled) {
       continue;
     }
 
     float offset_x = (window_size.x - min_dimension) / 2.0f;
     float offset_y = (window_size.y - min_dimension) / 2.0f;
+    Vector2D world = world_position(offsets, e, pos);
 
     sf::Vector2f new_pos(
-        static_cast<float>((pos.pos.x + 1.0) * min_dimension / deux) + offset_x,
-        static_cast<float>((pos.pos.y + 1.0) * min_dimension / deux)
-            + offset_y);
+        static_cast<float>((world.x + 1.0) * min_dimension / deux) + offset_x,
+        static_cast<float>((world.y + 1.0) * min_dimension / deux) + offset_y);
 
     if (new_pos.x < view_pos.x - (view_size.x / 2)
         || new_pos.x > view_pos.x + (view_size.x / 2))
@@ -406,7 +410,11 @@ void SFMLRenderer::render_texts(Registry& r,
                                 float min_dimension,
                                 const sf::Vector2u& window_size)
 {
-  for (auto&& [i, pos, draw, txt] : ZipperIndex<Position, Drawable, Text>(r)) {
+  auto const& offsets = r.get_components<Offset>();
+
+  for (auto&& [i, pos, draw, txt] :
+       ZipperIndex<Position const, Drawable, Text const>(r))
+  {
     if (!draw.enabled) {
       continue;
     }
@@ -444,11 +452,11 @@ void SFMLRenderer::render_texts(Registry& r,
 
     float offset_x = (window_size.x - min_dimension) / deux;
     float offset_y = (window_size.y - min_dimension) / deux;
+    Vector2D world = world_position(offsets, i, pos);
 
     sf::Vector2f new_pos(
-        static_cast<float>((pos.pos.x + 1.0) * min_dimension / deux) + offset_x,
-        static_cast<float>((pos.pos.y + 1.0) * min_dimension / deux)
-            + offset_y);
+        static_cast<float>((world.x + 1.0) * min_dimension / deux) + offset_x,
+        static_cast<float>((world.y + 1.0) * min_dimension / deux) + offset_y);
 
     _text.value().setString(text_str);
     _text.value().setCharacterSize(final_size);
@@ -483,19 +491,22 @@ void SFMLRenderer::render_bars(Registry& r,
                                float min_dimension,
                                const sf::Vector2u& window_size)
 {
-  for (auto&& [drawable, position, bar] : Zipper<Drawable, Position, Bar>(r)) {
+  auto const& offsets = r.get_components<Offset>();
+
+  for (auto&& [e, drawable, position, bar] :
+       ZipperIndex<Drawable const, Position const, Bar const>(r))
+  {
     if (!drawable.enabled) {
       continue;
     }
 
     float offset_x = (window_size.x - min_dimension) / 2.0f;
     float offset_y = (window_size.y - min_dimension) / 2.0f;
+    Vector2D world = world_position(offsets, e, position);
 
     sf::Vector2f new_pos(
-        static_cast<float>((position.pos.x + 1.0) * min_dimension / 2.0f)
-            + offset_x,
-        static_cast<float>((position.pos.y + 1.0) * min_dimension / 2.0f)
-            + offset_y);
+        static_cast<float>((world.x + 1.0) * min_dimension / 2.0f) + offset_x,
+        static_cast<float>((world.y + 1.0) * min_dimension / 2.0f) + offset_y);
     sf::Vector2f size(static_cast<float>(bar.size.x * min_dimension),
                       static_cast<float>(bar.size.y * min_dimension));
     sf::Vector2f offset(static_cast<float>(bar.offset.x * min_dimension),
@@ -535,8 +546,10 @@ void SFMLRenderer::render_animated_sprites(
     const sf::Vector2f& view_size,
     const sf::Vector2f& view_pos)
 {
+  auto const& offsets = r.get_components<Offset>();
+
   for (auto&& [entity, pos, draw, anim] :
-       ZipperIndex<Position, Drawable, AnimatedSprite>(r))
+       ZipperIndex<Position const, Drawable, AnimatedSprite const>(r))
   {
     if (!draw.enabled) {
       continue;
@@ -547,11 +560,11 @@ void SFMLRenderer::render_animated_sprites(
 
     float offset_x = (window_size.x - min_dimension) / deux;
     float offset_y = (window_size.y - min_dimension) / deux;
+    Vector2D world = world_position(offsets, entity, pos);
 
     sf::Vector2f new_pos(
-        static_cast<float>((pos.pos.x + 1.0) * min_dimension / deux) + offset_x,
-        static_cast<float>((pos.pos.y + 1.0) * min_dimension / deux)
-            + offset_y);
+        static_cast<float>((world.x + 1.0) * min_dimension / deux) + offset_x,
+        static_cast<float>((world.y + 1.0) * min_dimension / deux) + offset_y);
 
     AnimationData anim_data = anim.animations.at(anim.current_animation);
 
@@ -609,7 +622,7 @@ void SFMLRenderer::render_animated_sprites(
 
     float rotation = 0.0f;
 
-    auto facings = this->_registry.get().get_components<Facing>();
+    auto const& facings = this->_registry.get().get_components<Facing>();
 
     if (facings.size() > entity && facings.at(entity).has_value()) {
       if (facings.at(entity).value().plane) {
@@ -695,15 +708,17 @@ void SFMLRenderer::hover_system(Registry& r)
 {
   sf::Vector2i tmp = sf::Mouse::getPosition(_window);
   Vector2D mouse_pos = screen_to_world(tmp);
+  auto const& offsets = r.get_components<Offset>();
 
   for (const auto&& [e, clickable, pos, collision] :
-       ZipperIndex<Clickable, Position, Collidable>(r))
+       ZipperIndex<Clickable const, Position const, Collidable const>(r))
   {
     if (!r.is_in_main_scene(e)) {
       continue;
     }
-    Rect entity_rect = {.x = pos.pos.x,
-                        .y = pos.pos.y,
+    Vector2D world = world_position(offsets, e, pos);
+    Rect entity_rect = {.x = world.x,
+                        .y = world.y,
                         .width = collision.size.x * 2,
                         .height = collision.size.y * 2};
     if (entity_rect.contains(mouse_pos.x, mouse_pos.y)) {
@@ -722,9 +737,14 @@ void SFMLRenderer::button_system(Registry& r)
 {
   sf::Vector2i tmp = sf::Mouse::getPosition(_window);
   Vector2D mouse_pos = screen_to_world(tmp);
+  auto const& offsets = r.get_components<Offset>();
 
   for (auto&& [e, draw, anim, button, pos, collision] :
-       ZipperIndex<Drawable, AnimatedSprite, Button, Position, Collidable>(r))
+       ZipperIndex<Drawable const,
+                   AnimatedSprite const,
+                   Button,
+                   Position const,
+                   Collidable const>(r))
   {
     if (!draw.enabled || !r.is_in_main_scene(e)) {
       continue;
@@ -737,8 +757,9 @@ void SFMLRenderer::button_system(Registry& r)
       continue;
     }
     AnimationData hover_anim_data = anim.animations.at("hover");
-    Rect entity_rect = {.x = pos.pos.x,
-                        .y = pos.pos.y,
+    Vector2D world = world_position(offsets, e, pos);
+    Rect entity_rect = {.x = world.x,
+                        .y = world.y,
                         .width = collision.size.x * 2,
                         .height = collision.size.y * 2};
     if (entity_rect.contains(mouse_pos.x, mouse_pos.y)) {
@@ -21,7 +21,8 @@ void SFMLRenderer::render_sliders(Registry& r,
                                   float min_dimension,
                                   const sf::Vector2u& window_size)
 {
-  for (const auto&& [draw, pos, slider] : Zipper<Drawable, Position, Slider>(r))
+  for (const auto&& [draw, pos, slider] :
+       Zipper<Drawable const, Position const, Slider const>(r))
   {
     if (!draw.enabled) {
       continue;
@@ -58,7 +59,9 @@ void SFMLRenderer::render_sliders(Registry& r,
 
 void SFMLRenderer::slider_system(Registry& r) const
 {
-  for (auto&& [pos, draw, slider] : Zipper<Position, Drawable, Slider>(r)) {
+  for (auto&& [pos, draw, slider] :
+       Zipper<Position const, Drawable const, Slider>(r))
+  {
     if (!draw.enabled || !slider.selected) {
       continue;
     }
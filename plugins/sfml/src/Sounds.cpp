@@ -121,13 +121,13 @@ void SFMLRenderer::musics_system(Registry& r)
 
 void SFMLRenderer::volumes_system(Registry& r)
 {
-  for (auto&& [s, master_volume] : Zipper<Scene, MasterVolume>(r)) {
+  for (auto&& [s, master_volume] : Zipper<Scene const, MasterVolume const>(r)) {
     this->_master_volume = master_volume.value;
   }
-  for (auto&& [s, sfx_volume] : Zipper<Scene, SFXVolume>(r)) {
+  for (auto&& [s, sfx_volume] : Zipper<Scene const, SFXVolume const>(r)) {
     this->_sfx_volume = sfx_volume.value;
   }
-  for (auto&& [s, music_volume] : Zipper<Scene, MusicVolume>(r)) {
+  for (auto&& [s, music_volume] : Zipper<Scene const, MusicVolume const>(r)) {
     this->_music_volume = music_volume.value;
   }
 }
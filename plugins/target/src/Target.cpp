@@ -45,7 +45,7 @@ void Target::target_system(Registry& reg)
   auto& faces = reg.get_components<Facing>();
 
   for (auto&& [i, follower, position, direction, speed] :
-       ZipperIndex<Follower, Position, Direction, Speed>(reg))
+       ZipperIndex<Follower, Position const, Direction, Speed const>(reg))
   {
     if (reg.is_entity_dying(i) || follower.lost_target) {
       continue;
@@ -130,7 +130,9 @@ void UI::update_anim_system(Registry& r)
 {
   auto now = r.clock().now();
 
-  for (auto&& [e, drawable, anim] : ZipperIndex<Drawable, AnimatedSprite>(r)) {
+  for (auto&& [e, drawable, anim] :
+       ZipperIndex<Drawable const, AnimatedSprite>(r))
+  {
     if (!drawable.enabled) {
       continue;
     }
@@ -240,7 +242,8 @@ std::optional<AnimationData> UI::parse_animation_data(JsonObject const& obj,
 void UI::init_animated_sprite(Ecs::Entity const& entity,
                               const JsonObject& obj)
 {
-  std::unordered_map<std::string, AnimationData> animations;
+  AnimatedSprite::Animations animations(
+      &this->_registry.get().memory_resource());
 
   std::optional<JsonArray> animations_obj =
       get_value<AnimatedSprite, JsonArray>(
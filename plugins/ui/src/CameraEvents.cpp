@@ -16,7 +16,9 @@ void UI::cam_target_event(const CamAggroEvent& e)
     return;
   }
   target = positions.at(e.target).value().pos;
-  for (auto&& [pos, cam] : Zipper<Position, Camera>(this->_registry.get())) {
+  for (auto&& [pos, cam] :
+       Zipper<Position const, Camera>(this->_registry.get()))
+  {
     cam.target = target;
     cam.moving = true;
   }
@@ -9,7 +9,7 @@
 void UI::input_system(Registry& r)
 {
   for (const auto&& [e, draw, input, anim] :
-       ZipperIndex<Drawable, Input, AnimatedSprite>(r))
+       ZipperIndex<Drawable const, Input const, AnimatedSprite const>(r))
   {
     if (!r.is_in_main_scene(e) || !draw.enabled) {
       continue;
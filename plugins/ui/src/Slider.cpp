@@ -90,7 +90,9 @@ void UI::init_slider(const Ecs::Entity& e, const JsonObject& obj)
 
 void on_click_slider(Registry& r, const MousePressedEvent& event)
 {
-  for (auto&& [draw, slider, pos] : Zipper<Drawable, Slider, Position>(r)) {
+  for (auto&& [draw, slider, pos] :
+       Zipper<Drawable const, Slider, Position const>(r))
+  {
     if (!draw.enabled) {
       continue;
     }
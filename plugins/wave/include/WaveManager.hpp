@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 #include "Json/JsonParser.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/Registry.hpp"
 #include "patterns/IPatternStrategy.hpp"
@@ -24,7 +25,7 @@ private:
   void init_wave(Ecs::Entity const& entity, JsonObject const& obj);
   void init_formation(Ecs::Entity const& entity, JsonObject const& obj);
 
-  void spawn_wave_entities(Ecs::Entity wave_entity, std::vector<std::function<void()>> &event_to_emit);
+  void spawn_wave_entities(Ecs::Entity wave_entity, CommandBuffer& commands);
 
   void wave_formation_system(Registry& r);
   void wave_spawn_system(Registry& r);
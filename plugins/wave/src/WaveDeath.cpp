@@ -21,13 +21,15 @@
 
 void WaveManager::wave_death_system(Registry& r)
 {
-  for (auto&& [wave_entity, wave] : ZipperIndex<Wave>(r)) {
+  for (auto&& [wave_entity, wave] : ZipperIndex<Wave const>(r)) {
     if (!wave.tracked || !wave.spawned) {
       continue;
     }
 
     int remaining = 0;
-    for (auto&& [entity, tag] : ZipperIndex<WaveTag>(this->_registry.get())) {
+    for (auto&& [entity, tag] :
+         ZipperIndex<WaveTag const>(this->_registry.get()))
+    {
       if (tag.wave_id == wave.id
           && !this->_registry.get().is_entity_dying(entity))
       {
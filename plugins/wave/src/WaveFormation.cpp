@@ -12,14 +12,15 @@ void WaveManager::wave_formation_system(Registry& r)
 {
   auto dt = r.clock().delta_seconds();
 
-  for (auto&& [wave_entity, wave, formation] : ZipperIndex<Wave, Formation>(r))
+  for (auto&& [wave_entity, wave, formation] :
+       ZipperIndex<Wave const, Formation const>(r))
   {
     if (r.is_entity_dying(wave_entity) || !formation.active) {
       continue;
     }
 
     std::vector<Ecs::Entity> wave_entities;
-    for (auto&& [entity, tag] : ZipperIndex<WaveTag>(r)) {
+    for (auto&& [entity, tag] : ZipperIndex<WaveTag const>(r)) {
       if (tag.wave_id == wave.id && !r.is_entity_dying(entity)
           && r.has_component<Position>(entity))
       {
@@ -39,7 +40,7 @@ void WaveManager::wave_formation_system(Registry& r)
     center = center / static_cast<double>(wave_entities.size());
 
     for (auto entity_id : wave_entities) {
-      auto& pos_opt = r.get_components<Position>()[entity_id];
+      auto& pos_opt = r.get_components<Position>().modify(entity_id);
       auto& wave_tag = r.get_components<WaveTag>()[entity_id];
 
       Vector2D desired_pos = center + wave_tag->formation_offset;
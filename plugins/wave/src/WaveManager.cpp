@@ -58,7 +58,9 @@ std::optional<Ecs::Entity> WaveManager::find_wave_by_id(std::size_t id)
 {
   std::optional<Ecs::Entity> wave_opt;
 
-  for (auto&& [wave_entity, wave] : ZipperIndex<Wave>(this->_registry.get())) {
+  for (auto&& [wave_entity, wave] :
+       ZipperIndex<Wave const>(this->_registry.get()))
+  {
     if (wave.id == id) {
       wave_opt.emplace(wave_entity);
     }
@@ -11,7 +11,8 @@
 #include "plugin/components/WaveTag.hpp"
 #include "plugin/events/EntityManagementEvent.hpp"
 
-void WaveManager::spawn_wave_entities(Ecs::Entity wave_entity, std::vector<std::function<void()>> &event_to_emit)
+void WaveManager::spawn_wave_entities(Ecs::Entity wave_entity,
+                                      CommandBuffer& commands)
 {
   auto& wave =
       this->_registry.get().get_components<Wave>()[wave_entity].value();
@@ -83,8 +84,8 @@ void WaveManager::spawn_wave_entities(Ecs::Entity wave_entity, std::vector<std::
       }
     }
 
-    event_to_emit.emplace_back([this, wave, entity_additionals]() {this->_event_manager.get().emit<LoadEntityTemplate>(wave.entity_template,
-                                                        entity_additionals);});
+    commands.emit<LoadEntityTemplate>(wave.entity_template,
+                                      std::move(entity_additionals));
   }
   if (!wave.tracked) {
     this->_event_manager.get().emit<DeleteEntity>(wave_entity);
@@ -93,8 +94,6 @@ void WaveManager::spawn_wave_entities(Ecs::Entity wave_entity, std::vector<std::
 
 void WaveManager::wave_spawn_system(Registry& r)
 {
-  std::vector<std::function<void()>> event_to_emit;
-
   for (auto&& [entity, wave] : ZipperIndex<Wave>(r)) {
     if (r.is_entity_dying(entity)) {
       continue;
@@ -107,9 +106,6 @@ void WaveManager::wave_spawn_system(Registry& r)
     this->_event_manager.get().emit<ComponentBuilder>(
         entity, r.get_component_key<Wave>(), wave.to_bytes());
 
-    spawn_wave_entities(entity, event_to_emit);
-  }
-  for (auto const& fn : event_to_emit) {
-    fn();
+    spawn_wave_entities(entity, r.commands());
   }
 }
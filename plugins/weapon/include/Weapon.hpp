@@ -58,4 +58,9 @@ private:
   template<typename WeaponType>
   void emit_weapon_component_update(Ecs::Entity entity,
                                     const WeaponType& weapon);
+
+  // Same as emit_weapon_component_update(), from a concurrent system
+  template<typename WeaponType>
+  void record_weapon_component_update(Ecs::Entity entity,
+                                      const WeaponType& weapon);
 };
@@ -2,6 +2,7 @@
 
 #include "NetworkShared.hpp"
 #include "Weapon.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/zipper/ZipperIndex.hpp"
 #include "plugin/Hooks.hpp"
 #include "plugin/components/AnimatedSprite.hpp"
@@ -109,6 +110,16 @@ void Weapon::emit_weapon_component_update(Ecs::Entity entity,
       weapon.to_bytes());
 }
 
+template<typename WeaponType>
+void Weapon::record_weapon_component_update(Ecs::Entity entity,
+                                            const WeaponType& weapon)
+{
+  this->_registry.get().commands().emit<ComponentBuilder>(
+      entity,
+      this->_registry.get().get_component_key<WeaponType>(),
+      weapon.to_bytes());
+}
+
 template<typename WeaponType>
 void Weapon::handle_reload_system(
     std::chrono::high_resolution_clock::time_point now)
@@ -124,7 +135,7 @@ void Weapon::handle_reload_system(
         weapon.remaining_magazine -= 1;
 
         // Emit ComponentBuilder for reload state change
-        emit_weapon_component_update(entity, weapon);
+        record_weapon_component_update(entity, weapon);
       }
     }
   }
@@ -248,7 +248,7 @@ void Weapon::charge_weapon_system(
     // Keep searching each frame until we find it (LoadEntityTemplate is async)
     if (!weapon.charge_indicator_entity.has_value()) {
       for (auto&& [indicator_entity, marker] :
-           ZipperIndex<IdStorage>(this->_registry.get()))
+           ZipperIndex<IdStorage const>(this->_registry.get()))
       {
         if (marker.id_s == entity
             && marker.context == "charge_weapon_indicator")
@@ -272,7 +272,7 @@ void Weapon::charge_weapon_system(
           }
 
           // Emit ComponentBuilder when indicator entity is found
-          emit_weapon_component_update(entity, weapon);
+          record_weapon_component_update(entity, weapon);
           break;
         }
       }
@@ -287,7 +287,7 @@ void Weapon::charge_weapon_system(
     // Emit ComponentBuilder for charge level change (every frame while
     // charging)
     if (weapon.current_charge_level != old_charge_level) {
-      emit_weapon_component_update(entity, weapon);
+      record_weapon_component_update(entity, weapon);
     }
 
     if (weapon.charge_indicator_entity.has_value()) {
@@ -302,7 +302,7 @@ void Weapon::charge_weapon_system(
         sprite.scale = weapon.charge_indicator_base_scale * scale_factor;
 
         // Emit ComponentBuilder for sprite scale change
-        this->_event_manager.get().emit<ComponentBuilder>(
+        this->_registry.get().commands().emit<ComponentBuilder>(
             weapon.charge_indicator_entity.value(),
             this->_registry.get().get_component_key<Sprite>(),
             sprite.to_bytes());
@@ -326,7 +326,7 @@ void Weapon::charge_weapon_system(
                           .sprite_size.x
               / 2;
         }
-        this->_event_manager.get().emit<ComponentBuilder>(
+        this->_registry.get().commands().emit<ComponentBuilder>(
             weapon.charge_indicator_entity.value(),
             this->_registry.get().get_component_key<AnimatedSprite>(),
             animated_sprite.to_bytes());
@@ -340,7 +340,7 @@ void Weapon::charge_weapon_system(
         indicator_pos.pos = pos.pos + offset;
 
         // Emit ComponentBuilder for position update
-        this->_event_manager.get().emit<ComponentBuilder>(
+        this->_registry.get().commands().emit<ComponentBuilder>(
             weapon.charge_indicator_entity.value(),
             this->_registry.get().get_component_key<Position>(),
             indicator_pos.to_bytes());
@@ -61,7 +61,7 @@ void Weapon::delayed_weapon_system(
   handle_reload_system<DelayedWeapon>(now);
 
   for (auto&& [entity, weapon, pos] :
-       ZipperIndex<DelayedWeapon, Position>(_registry.get()))
+       ZipperIndex<DelayedWeapon, Position const>(_registry.get()))
   {
     if (!weapon.has_pending_shot) {
       continue;
@@ -106,13 +106,13 @@ void Weapon::delayed_weapon_system(
                 .to_bytes());
       }
 
-      this->_event_manager.get().emit<LoadEntityTemplate>(weapon.bullet_type,
-                                                          additional);
+      this->_registry.get().commands().emit<LoadEntityTemplate>(
+          weapon.bullet_type, additional);
 
       weapon.has_pending_shot = false;
 
       // Emit ComponentBuilder for pending shot state change
-      emit_weapon_component_update(entity, weapon);
+      record_weapon_component_update(entity, weapon);
     }
   }
 }
@@ -3,6 +3,7 @@
 
 #include "Weapon.hpp"
 
+#include "EntityExpose.hpp"
 #include "WeaponHelpers.hpp"
 #include "ecs/EmitEvent.hpp"
 #include "ecs/EventManager.hpp"
@@ -78,12 +79,25 @@ Weapon::Weapon(Registry& r, EventManager& em, EntityLoader& l)
     }
   })
 
-  _registry.get().add_system([this](Registry& r)
-                             { this->basic_weapon_system(r.clock().now()); });
-  _registry.get().add_system([this](Registry& r)
-                             { this->charge_weapon_system(r.clock().now()); });
-  _registry.get().add_system([this](Registry& r)
-                             { this->delayed_weapon_system(r.clock().now()); });
+  _registry.get().add_concurrent_system<BasicWeapon>(
+      [this](Registry& r, SparseArray<BasicWeapon>&)
+      { this->basic_weapon_system(r.clock().now()); });
+  _registry.get()
+      .add_concurrent_system<ChargeWeapon,
+                             Position,
+                             IdStorage const,
+                             Sprite,
+                             AnimatedSprite>(
+          [this](Registry& r, auto&&...)
+          { this->charge_weapon_system(r.clock().now()); });
+  _registry.get()
+      .add_concurrent_system<DelayedWeapon,
+                             Position const,
+                             Direction const,
+                             Facing const,
+                             Team const>(
+          [this](Registry& r, auto&&...)
+          { this->delayed_weapon_system(r.clock().now()); });
   _registry.get().add_system([this](Registry&)
                              { this->apply_scale_modifiers(); });
 }
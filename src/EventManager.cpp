@@ -1,37 +1,88 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "ecs/EventManager.hpp"
 
 #include "ecs/Registry.hpp"
 
+std::optional<EventTypeId> EventManager::find_event_id(
+    std::string const& name) const
+{
+  auto it = this->_name_ids.find(name);
+
+  if (it == this->_name_ids.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::string const& EventManager::event_name(EventTypeId id) const
+{
+  return this->_named.at(id).name;
+}
+
+std::vector<std::string> EventManager::event_names() const
+{
+  std::vector<std::string> names;
+
+  names.reserve(this->_named.size());
+  for (auto const& named : this->_named) {
+    names.push_back(named.name);
+  }
+  return names;
+}
+
+EventManager::NamedEvent const* EventManager::find_named(EventTypeId id) const
+{
+  return id < this->_named.size() ? &this->_named[id] : nullptr;
+}
+
 void EventManager::emit(Registry& r,
                         std::string const& name,
                         JsonObject const& args,
                         std::optional<Ecs::Entity> entity)
 {
-  if (!_index_getter.contains_second(name)) {
-    return;
-  }
-  std::type_index type_id = _index_getter.at_second(name);
-  if (!_handlers.contains(type_id)) {
-    return;
+  std::optional<EventTypeId> id = this->find_event_id(name);
+
+  if (id) {
+    this->emit(r, *id, args, entity);
   }
+}
 
-  auto builder = std::any_cast<std::function<std::any(
-      Registry&, JsonObject const&, std::optional<Ecs::Entity>)>>(
-      _builders.at(type_id));
-  std::any event = builder(r, args, entity);
+void EventManager::emit(Registry& r,
+                        EventTypeId id,
+                        JsonObject const& args,
+                        std::optional<Ecs::Entity> entity)
+{
+  NamedEvent const* named = this->find_named(id);
 
-  auto invoker =
-      std::any_cast<std::function<void(const std::any&, const std::any&)>>(
-          _invokers.at(type_id));
-  invoker(_handlers.at(type_id), event);
+  if (named != nullptr && named->emit_json) {
+    named->emit_json(r, args, entity);
+  }
 }
 
 void EventManager::emit(std::string const& name, ByteArray const& data)
 {
-  if (!this->_byte_emitter.contains(name)) {
-    return;
+  std::optional<EventTypeId> id = this->find_event_id(name);
+
+  if (id) {
+    this->emit(*id, data);
+  }
+}
+
+void EventManager::emit(EventTypeId id, ByteArray const& data)
+{
+  NamedEvent const* named = this->find_named(id);
+
+  if (named != nullptr && named->emit_bytes) {
+    named->emit_bytes(data);
   }
-  this->_byte_emitter.at(name)(data);
 }
 
 ByteArray EventManager::convert_event_entity(
@@ -39,10 +90,25 @@ ByteArray EventManager::convert_event_entity(
     ByteArray const& event,
     std::unordered_map<Ecs::Entity, Ecs::Entity> const& map)
 {
-  if (!this->_entity_converter.contains(id)) {
+  std::optional<EventTypeId> type = this->find_event_id(id);
+
+  if (!type) {
     return event;
   }
-  return this->_entity_converter.at(id)(event, map);
+  return this->convert_event_entity(*type, event, map);
+}
+
+ByteArray EventManager::convert_event_entity(
+    EventTypeId id,
+    ByteArray const& event,
+    std::unordered_map<Ecs::Entity, Ecs::Entity> const& map)
+{
+  NamedEvent const* named = this->find_named(id);
+
+  if (named == nullptr || !named->change_entity) {
+    return event;
+  }
+  return named->change_entity(event, map);
 }
 
 ByteArray EventManager::get_event_with_id(Registry& r,
@@ -50,16 +116,103 @@ ByteArray EventManager::get_event_with_id(Registry& r,
                                           JsonObject const& params,
                                           std::optional<Ecs::Entity> entity)
 {
-  return this->_json_builder.at(this->_index_getter.at_second(id))(
-      r, params, entity);
+  return this->get_event_with_id(r, this->_name_ids.at(id), params, entity);
+}
+
+ByteArray EventManager::get_event_with_id(Registry& r,
+                                          EventTypeId id,
+                                          JsonObject const& params,
+                                          std::optional<Ecs::Entity> entity)
+{
+  NamedEvent const& named = this->_named.at(id);
+
+  if (!named.json_to_bytes) {
+    throw std::out_of_range("no builder for event: " + named.name);
+  }
+  return named.json_to_bytes(r, params, entity);
+}
+
+void EventManager::enable_stats(bool enabled)
+{
+  this->_recording = enabled;
+  for (auto& handlers : this->_handlers) {
+    if (handlers != nullptr) {
+      handlers->recording = enabled;
+    }
+  }
+}
+
+bool EventManager::stats_enabled() const
+{
+  return this->_recording;
+}
+
+EventStats EventManager::stats() const
+{
+  EventStats stats {.enabled = this->_recording, .events = {}};
+
+  for (EventTypeId id = 0; id < this->_handlers.size(); id++) {
+    HandlerSlot const* slot = this->_handlers[id].get();
+
+    if (slot == nullptr) {
+      continue;
+    }
+    EventTypeStats& evt = stats.events.emplace_back(slot->stats);
+
+    evt.name = this->_named[id].name;
+    evt.id = id;
+    evt.handlers.reserve(slot->batch_stats.size() + slot->handler_stats.size());
+    evt.handlers.insert(
+        evt.handlers.end(), slot->batch_stats.begin(), slot->batch_stats.end());
+    evt.handlers.insert(evt.handlers.end(),
+                        slot->handler_stats.begin(),
+                        slot->handler_stats.end());
+    // Call order: by priority, batch handlers first on ties
+    std::ranges::stable_sort(
+        evt.handlers, std::ranges::greater {}, &HandlerStats::priority);
+  }
+  return stats;
+}
+
+void EventManager::reset_stats()
+{
+  for (auto& slot : this->_handlers) {
+    if (slot == nullptr) {
+      continue;
+    }
+    slot->stats = EventTypeStats {};
+    for (auto& handler : slot->handler_stats) {
+      handler.prevented = 0;
+      handler.time = LatencyHistogram {};
+    }
+    for (auto& handler : slot->batch_stats) {
+      handler.prevented = 0;
+      handler.time = LatencyHistogram {};
+    }
+  }
 }
 
 void EventManager::delete_all()
 {
-  this->_handlers.clear();
-  this->_byte_emitter.clear();
-  this->_builders.clear();
-  this->_json_builder.clear();
-  this->_entity_converter.clear();
-  this->_invokers.clear();
+  // Ids and names stay assigned, the find_handlers() caches and the ids
+  // resolved by callers may still point at them
+  for (auto& handlers : this->_handlers) {
+    handlers.reset();
+  }
+  for (auto& named : this->_named) {
+    named.emit_bytes = nullptr;
+    named.change_entity = nullptr;
+    named.emit_json = nullptr;
+    named.json_to_bytes = nullptr;
+  }
+}
+
+std::uint64_t EventManager::next_manager_uid()
+{
+  // Random base: each module linking the core gets its own counter, see
+  // Registry::next_registry_uid()
+  static std::atomic<std::uint64_t> next {
+      (static_cast<std::uint64_t>(std::random_device {}()) << 32U) | 1U};
+
+  return next.fetch_add(1, std::memory_order_relaxed);
 }
@@ -1,7 +1,17 @@
 
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
 #include <utility>
 #include <vector>
 
@@ -9,12 +19,181 @@
 
 #include "Json/JsonParser.hpp"
 #include "NetworkShared.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
 #include "ecs/JsonTemplateUtils.hpp"
 #include "ecs/Scenes.hpp"
 #include "ecs/Systems.hpp"
 #include "plugin/Byte.hpp"
 
+namespace
+{
+/**
+ * @brief Queue receiving the actions deferred by the current parallel task.
+ *
+ * nullptr outside of Registry::run_parallel(), defer() then runs actions
+ * right away.
+ */
+thread_local std::vector<std::function<void()>>* deferred_actions = nullptr;
+
+/**
+ * @brief Command buffer of the current parallel task.
+ *
+ * nullptr outside of Registry::run_parallel(), commands() then returns the
+ * Registry's buffer.
+ */
+thread_local CommandBuffer* task_commands = nullptr;
+
+/**
+ * @brief Filter threshold of the system running on this thread.
+ *
+ * 0 outside of systems, see Registry::changes_since().
+ */
+thread_local ChangeTick system_changes_since = 0;
+
+/**
+ * @brief Declared access of the concurrent system running on this thread.
+ *
+ * nullptr outside of concurrent systems, see
+ * Registry::check_system_access().
+ */
+thread_local SystemAccess const* system_access = nullptr;
+
+/**
+ * @brief Points deferred_actions and task_commands at the queues of a task
+ * for its lifetime.
+ */
+struct DeferScope
+{
+  DeferScope(std::vector<std::function<void()>>& queue,
+             CommandBuffer& commands,
+             SystemAccess const* access)
+      : previous(std::exchange(deferred_actions, &queue))
+      , previous_commands(std::exchange(task_commands, &commands))
+      , previous_access(std::exchange(system_access, access))
+  {
+  }
+
+  ~DeferScope()
+  {
+    deferred_actions = this->previous;
+    task_commands = this->previous_commands;
+    system_access = this->previous_access;
+  }
+
+  DeferScope(DeferScope const&) = delete;
+  DeferScope& operator=(DeferScope const&) = delete;
+
+  std::vector<std::function<void()>>* previous;
+  CommandBuffer* previous_commands;
+  SystemAccess const* previous_access;
+};
+
+/**
+ * @brief Raises a Registry's running flag until leave() or until the scope
+ * ends, even if a system throws.
+ */
+struct RunningScope
+{
+  explicit RunningScope(bool& flag)
+      : flag(flag)
+  {
+    this->flag = true;
+  }
+
+  ~RunningScope() { this->leave(); }
+
+  RunningScope(RunningScope const&) = delete;
+  RunningScope& operator=(RunningScope const&) = delete;
+
+  void leave() { this->flag = false; }
+
+  bool& flag;
+};
+
+/**
+ * @brief Points system_changes_since and system_access at the running
+ * system for its lifetime, even if it throws.
+ */
+struct SystemScope
+{
+  SystemScope(ChangeTick since, SystemAccess const* access)
+      : previous_since(std::exchange(system_changes_since, since))
+      , previous_access(std::exchange(system_access, access))
+  {
+  }
+
+  ~SystemScope()
+  {
+    system_changes_since = this->previous_since;
+    system_access = this->previous_access;
+  }
+
+  SystemScope(SystemScope const&) = delete;
+  SystemScope& operator=(SystemScope const&) = delete;
+
+  ChangeTick previous_since;
+  SystemAccess const* previous_access;
+};
+}  // namespace
+
+Registry::Registry()
+    : _commands(std::make_unique<CommandBuffer>())
+{
+}
+
+Registry::~Registry() = default;
+
+ComponentId Registry::assign_component_id(std::type_index type)
+{
+  auto [it, inserted] =
+      this->_component_ids.try_emplace(type, this->_component_storages.size());
+
+  if (!inserted) {
+    this->forget_component(it->second);
+    return it->second;
+  }
+  this->_component_storages.push_back(nullptr);
+  this->_delete_functions.emplace_back();
+  this->_shrink_functions.emplace_back();
+  this->_save_functions.emplace_back();
+  this->_restore_functions.emplace_back();
+  this->_stats_functions.emplace_back();
+  this->_dense_index_functions.emplace_back();
+  this->_dense_move_functions.emplace_back();
+  this->_group_of_component.push_back(nullptr);
+  this->_queries_by_component.emplace_back();
+
+  // Widen every entity signature when the ids outgrow the current words
+  std::size_t words = (this->_component_storages.size() + 63) / 64;
+  if (words != this->_mask_words) {
+    std::vector<std::uint64_t> masks(
+        (this->_component_masks.size() / std::max<std::size_t>(
+             this->_mask_words, 1))
+        * words);
+
+    for (std::size_t e = 0; e * words < masks.size(); e++) {
+      std::copy_n(this->_component_masks.begin()
+                      + static_cast<std::ptrdiff_t>(e * this->_mask_words),
+                  this->_mask_words,
+                  masks.begin() + static_cast<std::ptrdiff_t>(e * words));
+    }
+    this->_component_masks = std::move(masks);
+    this->_mask_words = words;
+  }
+  return it->second;
+}
+
+std::uint64_t Registry::next_registry_uid()
+{
+  // Random base: each module linking the core gets its own counter, a plugin
+  // creating a Registry must not reuse a tag known by the executable.
+  static std::atomic<std::uint64_t> next {
+      (static_cast<std::uint64_t>(std::random_device {}()) << 32U) | 1U};
+
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 Ecs::Entity Registry::spawn_entity()
 {
   Entity to_return = 0;
@@ -22,12 +201,87 @@ Ecs::Entity Registry::spawn_entity()
     to_return = this->_max;
     this->_max += 1;
   } else {
-    to_return = this->_dead_entities.front();
-    this->_dead_entities.pop();
+    to_return = this->take_dead_entity();
   }
   return to_return;
 }
 
+std::vector<Ecs::Entity> Registry::spawn_entities(std::size_t count)
+{
+  std::vector<Entity> spawned;
+
+  spawned.reserve(count);
+  while (spawned.size() < count && !this->_dead_entities.empty()) {
+    spawned.push_back(this->take_dead_entity());
+  }
+  std::size_t fresh = count - spawned.size();
+
+  for (std::size_t i = 0; i < fresh; i++) {
+    spawned.push_back(this->_max + i);
+  }
+  this->_max += fresh;
+  this->_component_masks.reserve(this->_max * this->_mask_words);
+  return spawned;
+}
+
+void Registry::set_id_reuse(IdReusePolicy policy)
+{
+  if (policy == IdReusePolicy::LOWEST_FIRST
+      && this->_id_reuse != IdReusePolicy::LOWEST_FIRST)
+  {
+    std::ranges::make_heap(this->_dead_entities, std::greater<> {});
+  }
+  this->_id_reuse = policy;
+}
+
+Ecs::Entity Registry::take_dead_entity()
+{
+  if (this->_id_reuse == IdReusePolicy::LOWEST_FIRST) {
+    std::ranges::pop_heap(this->_dead_entities, std::greater<> {});
+    Entity e = this->_dead_entities.back();
+    this->_dead_entities.pop_back();
+    return e;
+  }
+  Entity e = this->_dead_entities.front();
+  this->_dead_entities.pop_front();
+  return e;
+}
+
+void Registry::release_entity(Entity e)
+{
+  this->_dead_entities.push_back(e);
+  if (this->_id_reuse == IdReusePolicy::LOWEST_FIRST) {
+    std::ranges::push_heap(this->_dead_entities, std::greater<> {});
+  }
+}
+
+void Registry::shrink_to_fit()
+{
+  // Dead ids forming the top of the range are forgotten, _max comes down
+  std::vector<Entity> dead(this->_dead_entities.begin(),
+                           this->_dead_entities.end());
+  std::ranges::sort(dead);
+  while (!dead.empty() && dead.back() + 1 == this->_max) {
+    dead.pop_back();
+    this->_max -= 1;
+  }
+  std::erase_if(this->_dead_entities,
+                [this](Entity e) { return e >= this->_max; });
+  if (this->_id_reuse == IdReusePolicy::LOWEST_FIRST) {
+    std::ranges::make_heap(this->_dead_entities, std::greater<> {});
+  }
+  this->_dead_entities.shrink_to_fit();
+
+  this->_component_masks.resize(
+      std::min(this->_component_masks.size(), this->_max * this->_mask_words));
+  this->_component_masks.shrink_to_fit();
+  for (auto const& shrink : this->_shrink_functions) {
+    if (shrink) {
+      shrink();
+    }
+  }
+}
+
 void Registry::kill_entity(Entity const& e)
 {
   _entities_to_kill.insert(e);
@@ -40,24 +294,346 @@ bool Registry::is_entity_dying(Entity const& e) const
 
 void Registry::process_entity_deletions()
 {
+  bool bound = false;
+
   for (auto const& e : _entities_to_kill) {
-    for (auto it = _bindings.begin(); it != _bindings.end();) {
-      if (it->target_entity == e) {
-        it->deleter();
-        it = _bindings.erase(it);
-      } else {
-        ++it;
+    bound = bound || this->_binding_counts.contains(e);
+
+    std::size_t first = e * this->_mask_words;
+    if (first < this->_component_masks.size()) {
+      for (std::size_t w = 0; w < this->_mask_words; w++) {
+        std::uint64_t bits =
+            std::exchange(this->_component_masks[first + w], 0);
+
+        while (bits != 0) {
+          ComponentId id =
+              (w * 64) + static_cast<std::size_t>(std::countr_zero(bits));
+          this->leave_group(e, id);
+          this->_delete_functions[id](e);
+          for (QueryCache* cache : this->_queries_by_component[id]) {
+            cache->erase(e);
+          }
+          bits &= bits - 1;
+        }
       }
     }
+    this->release_entity(e);
+  }
 
-    for (auto const& [_, f] : this->_delete_functions) {
-      f(e);
+  if (bound) {
+    std::erase_if(this->_bindings,
+                  [this](Binding& binding)
+                  {
+                    if (!this->_entities_to_kill.contains(
+                            binding.target_entity))
+                    {
+                      return false;
+                    }
+                    binding.deleter();
+                    return true;
+                  });
+    for (auto const& e : _entities_to_kill) {
+      this->_binding_counts.erase(e);
     }
-    this->_dead_entities.push(e);
   }
   _entities_to_kill.clear();
 }
 
+void Registry::mark_component(Entity e, ComponentId id, bool present)
+{
+  std::size_t slot = (e * this->_mask_words) + (id / 64);
+  std::uint64_t bit = std::uint64_t {1} << (id % 64);
+
+  if (slot >= this->_component_masks.size()) {
+    if (!present) {
+      return;
+    }
+    this->_component_masks.resize((e + 1) * this->_mask_words, 0);
+  }
+  if (present) {
+    this->_component_masks[slot] |= bit;
+  } else {
+    this->_component_masks[slot] &= ~bit;
+  }
+
+  for (QueryCache* cache : this->_queries_by_component[id]) {
+    if (!present) {
+      cache->erase(e);
+    } else if (!cache->contains(e) && this->has_signature(e, cache->required()))
+    {
+      cache->insert(e);
+    }
+  }
+
+  OwningGroup* group = this->_group_of_component[id];
+  if (present && group != nullptr && !this->in_group(*group, e)
+      && this->has_signature(e, group->owned()))
+  {
+    if (this->_running_loops != 0) {
+      this->_deferred_group_entries.emplace_back(group, e);
+    } else {
+      this->enter_group(*group, e);
+    }
+  }
+}
+
+void Registry::forget_component(ComponentId id)
+{
+  std::uint64_t bit = std::uint64_t {1} << (id % 64);
+
+  for (std::size_t slot = id / 64; slot < this->_component_masks.size();
+       slot += this->_mask_words)
+  {
+    this->_component_masks[slot] &= ~bit;
+  }
+  for (QueryCache* cache : this->_queries_by_component[id]) {
+    cache->clear();
+  }
+  // The new storage is empty, no entity can still own the whole group
+  if (this->_group_of_component[id] != nullptr) {
+    this->_group_of_component[id]->resize(0);
+  }
+}
+
+bool Registry::has_signature(Entity e,
+                             std::vector<ComponentId> const& ids) const
+{
+  std::size_t first = e * this->_mask_words;
+
+  if (first >= this->_component_masks.size()) {
+    return false;
+  }
+  return std::ranges::all_of(
+      ids,
+      [this, first](ComponentId id)
+      {
+        return ((this->_component_masks[first + (id / 64)] >> (id % 64)) & 1U)
+            != 0;
+      });
+}
+
+QueryCache& Registry::query_cache(std::vector<ComponentId> required)
+{
+  std::ranges::sort(required);
+  required.erase(std::ranges::unique(required).begin(), required.end());
+
+  auto it = this->_queries.find(required);
+  if (it != this->_queries.end()) {
+    return *it->second;
+  }
+
+  auto cache = std::make_unique<QueryCache>(required);
+  this->fill_query(*cache);
+  for (ComponentId id : required) {
+    this->_queries_by_component[id].push_back(cache.get());
+  }
+  return *this->_queries.emplace(std::move(required), std::move(cache))
+              .first->second;
+}
+
+void Registry::fill_query(QueryCache& cache) const
+{
+  std::size_t entities = this->_component_masks.size()
+      / std::max<std::size_t>(this->_mask_words, 1);
+
+  cache.clear();
+  for (Entity e = 0; e < entities; e++) {
+    if (this->has_signature(e, cache.required())) {
+      cache.insert(e);
+    }
+  }
+}
+
+OwningGroup& Registry::owning_group(std::vector<ComponentId> owned)
+{
+  std::ranges::sort(owned);
+  owned.erase(std::ranges::unique(owned).begin(), owned.end());
+
+  for (auto const& group : this->_groups) {
+    if (group->owned() == owned) {
+      return *group;
+    }
+  }
+  for (ComponentId id : owned) {
+    if (this->_group_of_component[id] != nullptr) {
+      throw std::logic_error(
+          "Registry::owning_group: component owned by another group");
+    }
+    if (!this->_dense_move_functions[id]) {
+      throw std::logic_error("Registry::owning_group: tags cannot be owned");
+    }
+  }
+
+  auto& group = *this->_groups.emplace_back(
+      std::make_unique<OwningGroup>(std::move(owned)));
+  for (ComponentId id : group.owned()) {
+    this->_group_of_component[id] = &group;
+  }
+  this->fill_group(group);
+  return group;
+}
+
+void Registry::fill_group(OwningGroup& group)
+{
+  std::size_t entities = this->_component_masks.size()
+      / std::max<std::size_t>(this->_mask_words, 1);
+
+  group.resize(0);
+  for (Entity e = 0; e < entities; e++) {
+    if (this->has_signature(e, group.owned())) {
+      this->enter_group(group, e);
+    }
+  }
+}
+
+bool Registry::in_group(OwningGroup const& group, Entity e) const
+{
+  return this->_dense_index_functions[group.owned().front()](e)
+      < group.size();
+}
+
+void Registry::enter_group(OwningGroup& group, Entity e)
+{
+  for (ComponentId id : group.owned()) {
+    this->_dense_move_functions[id](e, group.size());
+  }
+  group.resize(group.size() + 1);
+}
+
+void Registry::leave_group(Entity e, ComponentId id)
+{
+  OwningGroup* group = this->_group_of_component[id];
+
+  if (group == nullptr || !this->in_group(*group, e)) {
+    return;
+  }
+  // Leaving swaps the entity out of every owned storage, which a running
+  // loop could be walking: empty the group instead and sort it afterwards
+  if (this->_running_loops != 0) {
+    group->resize(0);
+    this->_groups_to_sort.push_back(group);
+    return;
+  }
+  group->resize(group->size() - 1);
+  for (ComponentId owned : group->owned()) {
+    this->_dense_move_functions[owned](e, group->size());
+  }
+}
+
+void Registry::flush_group_moves()
+{
+  if (this->_groups_to_sort.empty() && this->_deferred_group_entries.empty())
+  {
+    return;
+  }
+  for (OwningGroup* group : std::exchange(this->_groups_to_sort, {})) {
+    this->fill_group(*group);
+  }
+  for (auto [group, e] : std::exchange(this->_deferred_group_entries, {})) {
+    if (!this->in_group(*group, e) && this->has_signature(e, group->owned()))
+    {
+      this->enter_group(*group, e);
+    }
+  }
+}
+
+RegistrySnapshot Registry::snapshot() const
+{
+  RegistrySnapshot snap;
+
+  this->snapshot(snap);
+  return snap;
+}
+
+void Registry::snapshot(RegistrySnapshot& into) const
+{
+  into._registry_uid = this->_uid;
+  into._storages.resize(this->_save_functions.size());
+  for (ComponentId id = 0; id < this->_save_functions.size(); id++) {
+    if (this->_save_functions[id]) {
+      this->_save_functions[id](into._storages[id]);
+    }
+  }
+  into._component_masks = this->_component_masks;
+  into._mask_words = this->_mask_words;
+  into._max = this->_max;
+  into._dead_entities = this->_dead_entities;
+  into._entities_to_kill = this->_entities_to_kill;
+  into._clock = this->_clock;
+}
+
+void Registry::restore(RegistrySnapshot const& snap)
+{
+  if (snap._registry_uid != this->_uid) {
+    throw std::invalid_argument(
+        "Registry::restore: snapshot of another registry");
+  }
+  for (ComponentId id = 0; id < this->_restore_functions.size(); id++) {
+    if (this->_restore_functions[id]) {
+      this->_restore_functions[id](
+          id < snap._storages.size() ? &snap._storages[id] : nullptr);
+    }
+  }
+
+  // Ids only grow, a narrower saved signature is widened with zero words
+  if (snap._mask_words == this->_mask_words) {
+    this->_component_masks = snap._component_masks;
+  } else {
+    std::size_t entities = snap._component_masks.size()
+        / std::max<std::size_t>(snap._mask_words, 1);
+
+    this->_component_masks.assign(entities * this->_mask_words, 0);
+    for (Entity e = 0; e < entities; e++) {
+      std::copy_n(snap._component_masks.begin()
+                      + static_cast<std::ptrdiff_t>(e * snap._mask_words),
+                  snap._mask_words,
+                  this->_component_masks.begin()
+                      + static_cast<std::ptrdiff_t>(e * this->_mask_words));
+    }
+  }
+  for (auto& [required, cache] : this->_queries) {
+    this->fill_query(*cache);
+  }
+  for (auto& group : this->_groups) {
+    this->fill_group(*group);
+  }
+  this->_max = snap._max;
+  this->_dead_entities = snap._dead_entities;
+  if (this->_id_reuse == IdReusePolicy::LOWEST_FIRST) {
+    std::ranges::make_heap(this->_dead_entities, std::greater<> {});
+  }
+  this->_entities_to_kill = snap._entities_to_kill;
+  this->_clock = snap._clock;
+}
+
+RegistryStats Registry::stats() const
+{
+  RegistryStats stats;
+
+  stats.live_entities = this->_max - this->_dead_entities.size();
+  stats.entity_ids = this->_max;
+  stats.dead_ids = this->_dead_entities.size();
+  stats.pending_kills = this->_entities_to_kill.size();
+  stats.signature_bytes =
+      this->_component_masks.capacity() * sizeof(std::uint64_t);
+  stats.systems =
+      this->_frequent_systems.size() + this->_added_systems.size();
+  stats.queries = this->_queries.size();
+  stats.groups = this->_groups.size();
+  stats.bindings = this->_bindings.size();
+  stats.component_hooks = this->_hooked_components.size();
+  stats.global_hooks = this->_global_hooks.size();
+  stats.components.resize(this->_stats_functions.size());
+  for (ComponentId id = 0; id < this->_stats_functions.size(); id++) {
+    stats.components[id].id = id;
+    stats.components[id].grouped = this->_group_of_component[id] != nullptr;
+    if (this->_stats_functions[id]) {
+      this->_stats_functions[id](stats.components[id]);
+    }
+  }
+  return stats;
+}
+
 void Registry::emplace_component(Entity const& to,
                                  std::string const& string_id,
                                  ByteArray const& bytes)
@@ -74,14 +650,247 @@ void Registry::run_systems(EventManager& em)
 {
   update_bindings(em);
 
-  std::vector<System<>> pending = this->_frequent_systems;
-  for (auto const& f : pending) {
-    f();
+  this->flush_systems();
+  RunningScope running(this->_running_systems);
+  for (auto const& batch : this->_system_batches) {
+    if (batch.size() == 1) {
+      this->run_system(this->_frequent_systems[batch.front()]);
+    } else {
+      this->run_parallel(
+          batch.size(),
+          [this, &batch](std::size_t i)
+          { this->run_system(this->_frequent_systems[batch[i]]); });
+    }
+    // The recorded changes and the next batch's writes must be newer than
+    // this batch's last run, so that its systems see them next frame
+    this->_change_tick += 1;
+    this->apply_commands(em);
   }
+  running.leave();
   process_entity_deletions();
   this->clock().tick();
 }
 
+void Registry::run_system(System<>& sys)
+{
+  if (!sys._enabled) {
+    return;
+  }
+  if (sys._scene != NO_SCENE_ID
+      && (sys._scene >= this->_scene_masks.size()
+          || ((this->_scene_masks[sys._scene]
+               >> static_cast<std::uint8_t>(SceneState::ACTIVE))
+              & 1U)
+              == 0))
+  {
+    return;
+  }
+  SystemScope scope(sys._last_run + 1,
+                    sys.access().exclusive ? nullptr : &sys.access());
+
+  sys._last_run = this->_change_tick;
+  sys();
+}
+
+void Registry::check_system_access(std::type_index const& type) const
+{
+  if (system_access == nullptr || type == typeid(Scene)) {
+    return;
+  }
+  if (std::ranges::find(system_access->reads, type)
+          == system_access->reads.end()
+      && std::ranges::find(system_access->writes, type)
+          == system_access->writes.end())
+  {
+    throw std::logic_error("concurrent system uses undeclared component "
+                           + this->_index_getter.at_first(type));
+  }
+}
+
+ChangeTick Registry::changes_since() const
+{
+  return system_changes_since;
+}
+
+void Registry::flush_systems()
+{
+  if (!this->_added_systems.empty()) {
+    for (auto& sys : this->_added_systems) {
+      if (!sys._removed) {
+        this->place_system(std::move(sys));
+      }
+    }
+    this->_added_systems.clear();
+  }
+  if (!this->_systems_dirty) {
+    return;
+  }
+  std::erase_if(this->_frequent_systems,
+                [](System<> const& sys) { return sys._removed; });
+  this->plan_systems();
+}
+
+System<>* Registry::find_system(SystemId id)
+{
+  auto match = [id](System<> const& sys)
+  { return sys._id == id && !sys._removed; };
+
+  auto it = std::ranges::find_if(this->_frequent_systems, match);
+  if (it != this->_frequent_systems.end()) {
+    return &*it;
+  }
+  it = std::ranges::find_if(this->_added_systems, match);
+  if (it != this->_added_systems.end()) {
+    return &*it;
+  }
+  return nullptr;
+}
+
+void Registry::enable_system(SystemId id)
+{
+  System<>* sys = this->find_system(id);
+
+  if (sys != nullptr && !sys->_enabled) {
+    sys->_enabled = true;
+    this->_systems_dirty = true;
+  }
+}
+
+void Registry::disable_system(SystemId id)
+{
+  System<>* sys = this->find_system(id);
+
+  if (sys != nullptr && sys->_enabled) {
+    sys->_enabled = false;
+    this->_systems_dirty = true;
+  }
+}
+
+bool Registry::is_system_enabled(SystemId id) const
+{
+  auto match = [id](System<> const& sys)
+  { return sys._id == id && sys._enabled && !sys._removed; };
+
+  return std::ranges::any_of(this->_frequent_systems, match)
+      || std::ranges::any_of(this->_added_systems, match);
+}
+
+void Registry::remove_system(SystemId id)
+{
+  System<>* sys = this->find_system(id);
+
+  if (sys == nullptr) {
+    return;
+  }
+  sys->_enabled = false;
+  sys->_removed = true;
+  this->_systems_dirty = true;
+  if (!this->_running_systems) {
+    this->flush_systems();
+  }
+}
+
+void Registry::bind_system_to_scene(SystemId id, std::string const& scene_name)
+{
+  System<>* sys = this->find_system(id);
+
+  if (sys != nullptr) {
+    sys->_scene = this->intern_scene(scene_name);
+  }
+}
+
+void Registry::plan_systems()
+{
+  std::vector<std::size_t> batch_of(this->_frequent_systems.size());
+  std::size_t band_start = 0;
+  std::size_t band_batch = 0;
+
+  this->_system_batches.clear();
+  for (std::size_t i = 0; i < this->_frequent_systems.size(); i++) {
+    auto const& sys = this->_frequent_systems[i];
+
+    if (i == 0 || sys._priority != this->_frequent_systems[i - 1]._priority) {
+      band_start = i;
+      band_batch = this->_system_batches.size();
+    }
+    if (!sys._enabled) {
+      continue;
+    }
+    std::size_t batch = band_batch;
+    for (std::size_t j = band_start; j < i; j++) {
+      if (this->_frequent_systems[j]._enabled
+          && sys.access().conflicts_with(this->_frequent_systems[j].access()))
+      {
+        batch = std::max(batch, batch_of[j] + 1);
+      }
+    }
+    if (batch == this->_system_batches.size()) {
+      this->_system_batches.emplace_back();
+    }
+    this->_system_batches[batch].push_back(i);
+    batch_of[i] = batch;
+  }
+  this->_systems_dirty = false;
+}
+
+ThreadPool& Registry::workers()
+{
+  if (!this->_workers) {
+    this->_workers = std::make_unique<ThreadPool>();
+  }
+  return *this->_workers;
+}
+
+void Registry::run_parallel(std::size_t count,
+                            std::function<void(std::size_t)> const& task)
+{
+  std::vector<std::vector<std::function<void()>>> deferred(count);
+  std::vector<CommandBuffer> commands(count);
+  SystemAccess const* access = system_access;
+
+  for (auto& buffer : commands) {
+    this->commands().lend_blocks(buffer, 1);
+  }
+
+  this->workers().run(count,
+                      [&task, &deferred, &commands, access](std::size_t i)
+                      {
+                        DeferScope scope(deferred[i], commands[i], access);
+                        task(i);
+                      });
+  // Forwarded to defer() so a nested job hands its actions to the outer one
+  for (auto& actions : deferred) {
+    for (auto& action : actions) {
+      this->defer(std::move(action));
+    }
+  }
+  for (auto& buffer : commands) {
+    this->commands().append(std::move(buffer));
+  }
+}
+
+void Registry::defer(std::function<void()> action)
+{
+  if (deferred_actions != nullptr) {
+    deferred_actions->push_back(std::move(action));
+    return;
+  }
+  action();
+}
+
+CommandBuffer& Registry::commands()
+{
+  if (task_commands != nullptr) {
+    return *task_commands;
+  }
+  return *this->_commands;
+}
+
+void Registry::apply_commands(EventManager& em)
+{
+  this->_commands->apply(*this, em);
+}
+
 void Registry::update_bindings(EventManager& em)
 {
   for (auto& binding : _bindings) {
@@ -103,11 +912,12 @@ void Registry::clear_bindings()
     binding.deleter();
   }
   _bindings.clear();
+  _binding_counts.clear();
 }
 
 void Registry::add_scene(std::string const& scene_name, SceneState state)
 {
-  _scenes.insert_or_assign(scene_name, state);
+  this->set_scene_state(scene_name, state);
   if (state == SceneState::ACTIVE || state == SceneState::MAIN) {
     activate_scene(scene_name);
   }
@@ -133,13 +943,9 @@ void Registry::setup_scene_systems()
 
 void Registry::activate_scene(std::string const& scene_name)
 {
-  if (!_scenes.contains(scene_name)) {
-    _scenes.insert({scene_name, SceneState::DISABLED});
-  }
-
   // If the scene is not already MAIN, set it to ACTIVE
-  if (_scenes[scene_name] != SceneState::MAIN) {
-    _scenes[scene_name] = SceneState::ACTIVE;
+  if (get_scene_state(scene_name) != SceneState::MAIN) {
+    this->set_scene_state(scene_name, SceneState::ACTIVE);
   }
 
   if (_active_scenes_set.contains(scene_name)) {
@@ -153,7 +959,7 @@ void Registry::activate_scene(std::string const& scene_name)
 void Registry::deactivate_scene(std::string const& scene_name)
 {
   if (_scenes.contains(scene_name)) {
-    _scenes[scene_name] = SceneState::DISABLED;
+    this->set_scene_state(scene_name, SceneState::DISABLED);
   }
 
   _active_scenes_set.erase(scene_name);
@@ -167,6 +973,7 @@ void Registry::deactivate_all_scenes()
 {
   for (auto& [name, state] : _scenes) {
     state = SceneState::DISABLED;
+    _scene_masks[_scene_ids.at(name)] = scene_level_mask(state);
   }
   _current_scene.clear();
   _active_scenes_set.clear();
@@ -205,6 +1012,31 @@ std::unordered_map<std::string, SceneState> const& Registry::get_scene_states()
   return _scenes;
 }
 
+SceneId Registry::intern_scene(std::string_view scene_name)
+{
+  auto it = _scene_ids.find(scene_name);
+
+  if (it != _scene_ids.end()) {
+    return it->second;
+  }
+  auto id = static_cast<SceneId>(_scene_masks.size());
+  _scene_ids.emplace(std::string(scene_name), id);
+  _scene_masks.push_back(0);
+  return id;
+}
+
+std::vector<std::uint8_t> const& Registry::get_scene_masks() const
+{
+  return _scene_masks;
+}
+
+void Registry::set_scene_state(std::string const& scene_name,
+                               SceneState state)
+{
+  _scenes.insert_or_assign(scene_name, state);
+  _scene_masks[this->intern_scene(scene_name)] = scene_level_mask(state);
+}
+
 std::vector<std::string> const& Registry::get_active_scenes() const
 {
   return _current_scene;
@@ -242,7 +1074,7 @@ bool Registry::is_in_main_scene(Entity e)
     return true;
   }
   return this->_main_scene.empty()
-      || this->get_components<Scene>()[e]->scene_name
+      || std::string_view(this->get_components<Scene>()[e]->scene_name)
       == this->_main_scene.front();
 }
 
@@ -285,8 +1117,12 @@ bool Registry::is_in_current_cene(Entity e)
   if (!this->has_component<Scene>(e)) {
     return false;
   }
-  return _active_scenes_set.contains(
-      this->get_components<Scene>()[e].value().scene_name);
+  SceneId id = this->get_components<Scene>()[e]->id;
+
+  return id < _scene_masks.size()
+      && ((_scene_masks[id] >> static_cast<std::uint8_t>(SceneState::ACTIVE))
+          & 1U)
+      != 0;
 }
 
 ByteArray Registry::convert_comp_entity(
@@ -325,7 +1161,7 @@ ByteArray Registry::get_byte_entity(Entity entity)
           {
             return pair_to_byte(
                 v,
-                std::function(string_to_byte),
+                std::function<ByteArray(std::string const&)>(string_to_byte),
                 std::function<ByteArray(ByteArray const&)>(
                     [](ByteArray const& v)
                     { return vector_to_byte(v, TTB_FUNCTION<Byte>()); }));
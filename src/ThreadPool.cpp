@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "ecs/ThreadPool.hpp"
+
+namespace
+{
+thread_local bool inside_task = false;
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t workers)
+{
+  this->_workers.reserve(workers);
+  for (std::size_t i = 0; i < workers; i++) {
+    this->_workers.emplace_back([this]() { this->worker_loop(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> guard(this->_lock);
+    this->_stopping = true;
+  }
+  this->_wake.notify_all();
+  for (auto& worker : this->_workers) {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::default_workers()
+{
+  std::size_t hardware = std::thread::hardware_concurrency();
+
+  return hardware > 1 ? hardware - 1 : 0;
+}
+
+std::size_t ThreadPool::concurrency() const
+{
+  return this->_workers.size() + 1;
+}
+
+void ThreadPool::run(std::size_t count,
+                     std::function<void(std::size_t)> const& task)
+{
+  if (count == 0) {
+    return;
+  }
+  if (inside_task || this->_workers.empty() || count == 1) {
+    for (std::size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_guard(this->_run_lock);
+  {
+    std::lock_guard<std::mutex> guard(this->_lock);
+    this->_task = &task;
+    this->_count = count;
+    this->_next = 0;
+    this->_pending = count;
+    this->_error = nullptr;
+    this->_generation += 1;
+  }
+  this->_wake.notify_all();
+  this->process_job();
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(this->_lock);
+    this->_done.wait(lock, [this]() { return this->_pending == 0; });
+    this->_task = nullptr;
+    error = std::exchange(this->_error, nullptr);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::worker_loop()
+{
+  std::size_t seen = 0;
+  std::unique_lock<std::mutex> lock(this->_lock);
+
+  while (true) {
+    this->_wake.wait(lock,
+                     [this, &seen]()
+                     { return this->_stopping || this->_generation != seen; });
+    if (this->_stopping) {
+      return;
+    }
+    seen = this->_generation;
+    lock.unlock();
+    this->process_job();
+    lock.lock();
+  }
+}
+
+void ThreadPool::process_job()
+{
+  std::unique_lock<std::mutex> lock(this->_lock);
+
+  while (this->_task != nullptr && this->_next < this->_count) {
+    std::size_t index = this->_next;
+    auto const& task = *this->_task;
+    std::exception_ptr error;
+
+    this->_next += 1;
+    lock.unlock();
+    inside_task = true;
+    try {
+      task(index);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    inside_task = false;
+    lock.lock();
+    if (error && !this->_error) {
+      this->_error = error;
+    }
+    this->_pending -= 1;
+    if (this->_pending == 0) {
+      this->_done.notify_all();
+    }
+  }
+}
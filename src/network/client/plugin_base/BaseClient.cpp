@@ -1,6 +1,7 @@
 #include <exception>
 #include <format>
 #include <optional>
+#include <string>
 #include <thread>
 
 #include "network/client/BaseClient.hpp"
@@ -50,7 +51,10 @@ BaseClient::BaseClient(std::string const& name,
     if (!this->_running) {
       _running = true;
 
-      this->_thread = std::thread(&BaseClient::connection_thread, this, event);
+      this->_thread = std::thread(&BaseClient::connection_thread,
+                                  this,
+                                  event,
+                                  this->_event_manager.get().event_names());
     } else {
       LOGGER("client", LogLevel::WARNING, "client already running");
     }
@@ -80,12 +84,19 @@ BaseClient::BaseClient(std::string const& name,
     if (!this->_running) {
       return false;
     }
-    this->_event_to_server.push(EventBuilder(
-        event.event_id,
-        this->_event_manager.get().convert_event_entity(
-            event.event_id,
-            event.data,
-            this->_server_indexes.get_second())));  // CLIENT -> SERVER
+    EventBuilder to_send(event);
+
+    if (!to_send.local_id) {
+      to_send.local_id =
+          this->_event_manager.get().find_event_id(to_send.event_id);
+    }
+    if (to_send.local_id) {
+      to_send.data = this->_event_manager.get().convert_event_entity(
+          *to_send.local_id,
+          to_send.data,
+          this->_server_indexes.get_second());  // CLIENT -> SERVER
+    }
+    this->_event_to_server.push(std::move(to_send));
   })
 
   this->_registry.get().add_system(
@@ -94,37 +105,50 @@ BaseClient::BaseClient(std::string const& name,
         if (!this->_running) {
           return;
         }
-        auto components = this->_component_queue.flush();
-        for (auto& server_comp : components) {
-          if (!this->_server_indexes.contains_first(server_comp.entity)) {
-            auto new_entity = r.spawn_entity();
-            this->_server_indexes.insert(server_comp.entity, new_entity);
-            this->_server_created.emplace(new_entity);
-          }
-          auto true_entity = this->_server_indexes.at_first(server_comp.entity);
-
-          try {
-            this->_loader.get().load_byte_component(
-                true_entity, server_comp, this->_server_indexes);
-          } catch (InvalidPackage const& e) {
-            LOGGER("client", LogLevel::ERR, e.what());
-          }
-        }
-      });
+        this->_component_queue.drain(
+            [this, &r](ComponentBuilder& server_comp)
+            {
+              if (!this->_server_indexes.contains_first(server_comp.entity)) {
+                auto new_entity = r.spawn_entity();
+                this->_server_indexes.insert(server_comp.entity, new_entity);
+                this->_server_created.emplace(new_entity);
+              }
+              auto true_entity =
+                  this->_server_indexes.at_first(server_comp.entity);
+
+              try {
+                this->_loader.get().load_byte_component(
+                    true_entity, server_comp, this->_server_indexes);
+              } catch (InvalidPackage const& e) {
+                LOGGER("client", LogLevel::ERR, e.what());
+              }
+            });
+      },
+      NETWORK_DRAIN_PRIORITY);
 
   this->_registry.get().add_system(
       [this](Registry& /*r*/)
       {
-        auto events = this->_event_from_server.flush();
-        for (auto& e : events) {
-          this->_event_manager.get().emit(
-              e.event_id,
-              this->_event_manager.get().convert_event_entity(
-                  e.event_id,
-                  e.data,
-                  this->_server_indexes.get_first()));  // SERVER -> CLIENT
-        }
-      });
+        this->_event_from_server.drain(
+            [this](EventBuilder& e)
+            {
+              EventManager& em = this->_event_manager.get();
+
+              if (!e.local_id) {
+                e.local_id = em.find_event_id(e.event_id);
+              }
+              if (!e.local_id) {
+                return;
+              }
+              // SERVER -> CLIENT
+              em.emit(*e.local_id,
+                      em.convert_event_entity(
+                          *e.local_id,
+                          e.data,
+                          this->_server_indexes.get_first()));
+            });
+      },
+      NETWORK_DRAIN_PRIORITY);
 
   SUBSCRIBE_EVENT(DeleteClientEntity, {
     this->_server_indexes.remove_second(event.entity);
@@ -163,11 +187,16 @@ BaseClient::~BaseClient()
   }
 }
 
-void BaseClient::connection_thread(ClientConnection const& c)
+void BaseClient::connection_thread(ClientConnection const& c,
+                                   std::vector<std::string> local_events)
 {
   try {
-    Client client(
-        c, _component_queue, _event_to_server, _event_from_server, _running);
+    Client client(c,
+                  _component_queue,
+                  _event_to_server,
+                  _event_from_server,
+                  _running,
+                  std::move(local_events));
     client.connect(this->_user_id);
   } catch (std::exception& e) {
     LOGGER("client",
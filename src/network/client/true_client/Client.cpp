@@ -16,15 +16,17 @@
 #include "plugin/CircularBuffer.hpp"
 
 Client::Client(ClientConnection const& c,
-               SharedQueue<ComponentBuilder>& shared_components,
+               MpscRing<ComponentBuilder>& shared_components,
                SharedQueue<EventBuilder>& shared_events,
-               SharedQueue<EventBuilder>& shared_exec_events,
-               std::atomic<bool>& running)
+               MpscRing<EventBuilder>& shared_exec_events,
+               std::atomic<bool>& running,
+               std::vector<std::string> local_events)
     : _socket(_io_c)
     , _components_to_create(std::ref(shared_components))
     , _events_to_transmit(std::ref(shared_events))
     , _event_to_exec(std::ref(shared_exec_events))
     , _running(running)
+    , _local_events(std::move(local_events))
     , _last_ping(std::chrono::steady_clock::now().time_since_epoch().count())
 {
   _socket.open(asio::ip::udp::v4());
@@ -1,5 +1,7 @@
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "ParserTypes.hpp"
 #include "ServerCommands.hpp"
@@ -111,6 +113,36 @@ std::optional<EventBuilder> Client::parse_event_build_cmd(
   return std::get<SUCCESS>(r).value;
 }
 
+std::optional<EventIdCommand> Client::parse_event_id_build_cmd(
+    ByteArray const& package)
+{
+  Result<EventIdCommand> r = parse_event_id_cmd()(package);
+
+  if (r.index() == ERR) {
+    LOGGER_EVTLESS(LogLevel::ERR,
+                   "client",
+                   std::format("Failed to read event id command : {}",
+                               std::get<ERR>(r).message));
+    return std::nullopt;
+  }
+  return std::get<SUCCESS>(r).value;
+}
+
+std::optional<std::vector<std::string>> Client::parse_event_table_cmd(
+    ByteArray const& package)
+{
+  Result<std::vector<std::string>> r = parse_event_table()(package);
+
+  if (r.index() == ERR) {
+    LOGGER_EVTLESS(LogLevel::ERR,
+                   "client",
+                   std::format("Failed to read event table : {}",
+                               std::get<ERR>(r).message));
+    return std::nullopt;
+  }
+  return std::get<SUCCESS>(r).value;
+}
+
 std::optional<ComponentBuilder> Client::parse_component_build_cmd(
     ByteArray const& package)
 {
@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include "NetworkCommun.hpp"
 #include "NetworkShared.hpp"
@@ -11,6 +14,8 @@
 const std::unordered_map<std::uint8_t, void (Client::*)(ByteArray const&)>
     Client::connected_table = {{SENDCOMP, &Client::handle_component_update},
                                {SENDEVENT, &Client::handle_event_creation},
+                               {SENDEVENTID, &Client::handle_event_id},
+                               {EVENTTABLE, &Client::handle_event_table},
                                {FFGONEXT, &Client::reset_acknowledge}};
 
 void Client::handle_connected_package(ConnectedPackage const& package)
@@ -85,8 +90,61 @@ void Client::handle_event_creation(ByteArray const& package)
   this->transmit_event(std::move(*parsed));
 }
 
+void Client::handle_event_id(ByteArray const& package)
+{
+  auto parsed = parse_event_id_build_cmd(package);
+
+  if (!parsed || !this->_event_table_ready.load(std::memory_order_acquire)
+      || parsed->event_id >= this->_server_to_local.size())
+  {
+    return;
+  }
+  std::optional<std::size_t> local = this->_server_to_local[parsed->event_id];
+
+  // Not registered by the client, like an unknown name
+  if (!local) {
+    return;
+  }
+  this->transmit_event(EventBuilder(*local, std::move(parsed->data)));
+}
+
+void Client::handle_event_table(ByteArray const& package)
+{
+  auto parsed = parse_event_table_cmd(package);
+
+  if (!parsed) {
+    return;
+  }
+  // Resent after a reset: the names do not change, only acknowledge again
+  if (this->_event_table_ready.load(std::memory_order_acquire)) {
+    this->send_connected(type_to_byte<Byte>(EVENTTABLEACK));
+    return;
+  }
+  std::unordered_map<std::string, std::size_t> local_ids;
+
+  for (std::size_t i = 0; i < this->_local_events.size(); i++) {
+    if (!this->_local_events[i].empty()) {
+      local_ids.try_emplace(this->_local_events[i], i);
+    }
+  }
+  this->_server_to_local.assign(parsed->size(), std::nullopt);
+  this->_local_to_server.assign(this->_local_events.size(), std::nullopt);
+  for (std::size_t i = 0; i < parsed->size(); i++) {
+    auto it = local_ids.find((*parsed)[i]);
+
+    if (it == local_ids.end()) {
+      continue;
+    }
+    this->_server_to_local[i] = it->second;
+    this->_local_to_server[it->second] = static_cast<std::uint32_t>(i);
+  }
+  this->_event_table_ready.store(true, std::memory_order_release);
+  this->send_connected(type_to_byte<Byte>(EVENTTABLEACK));
+}
+
 void Client::send_connected(ByteArray const& response, bool prioritary)
 {
+  std::lock_guard lock(this->_send_mutex);
   ByteArray compressed = PacketCompresser::compress_packet(response);
   std::vector<ByteArray> const& packages =
       compressed / get_package_division(compressed.size());
@@ -9,18 +9,17 @@
 #include "plugin/Byte.hpp"
 #include "plugin/events/NetworkEvents.hpp"
 
+// The receive thread is the only producer and the frame loop never waits on
+// it, so it can wait for room instead of dropping what the server sent
 void Client::transmit_component(ComponentBuilder&& to_transmit)
 {
-  this->_components_to_create.get().lock.lock();
-  this->_components_to_create.get().queue.push(std::move(to_transmit));
-  this->_components_to_create.get().lock.unlock();
+  this->_components_to_create.get().push(std::move(to_transmit),
+                                         this->_running.get());
 }
 
 void Client::transmit_event(EventBuilder&& to_transmit)
 {
-  this->_event_to_exec.get().lock.lock();
-  this->_event_to_exec.get().queue.push(std::move(to_transmit));
-  this->_event_to_exec.get().lock.unlock();
+  this->_event_to_exec.get().push(std::move(to_transmit), this->_running.get());
 }
 
 void Client::send_evt()
@@ -30,12 +29,25 @@ void Client::send_evt()
     auto const& events = this->_events_to_transmit.get().flush();
 
     for (auto const& evt : events) {
-      auto data = type_to_byte<Byte>(SENDEVENT) + evt.to_bytes();
-      this->send_connected(data);
+      this->send_connected(this->encode_event(evt));
     }
   }
 }
 
+ByteArray Client::encode_event(EventBuilder const& event) const
+{
+  if (event.local_id
+      && this->_event_table_ready.load(std::memory_order_acquire)
+      && *event.local_id < this->_local_to_server.size()
+      && this->_local_to_server[*event.local_id])
+  {
+    return type_to_byte<Byte>(SENDEVENTID)
+        + type_to_byte(*this->_local_to_server[*event.local_id]) + event.data;
+  }
+  // Before the table arrived, or unknown to the server: send the name
+  return type_to_byte<Byte>(SENDEVENT) + event.to_bytes();
+}
+
 static NetworkStatus::PacketLossLevel get_packet_loss_level(
     std::vector<std::size_t> const& it, std::size_t begin, std::size_t end)
 {
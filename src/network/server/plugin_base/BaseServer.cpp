@@ -49,7 +49,8 @@ BaseServer::BaseServer(std::string const& name,
                                 _components_to_update,
                                 _event_queue_to_client,
                                 _event_queue,
-                                _running);
+                                _running,
+                                this->_event_manager.get().event_names());
     LOGGER("server",
            LogLevel::INFO,
            std::format("Server started on port {}", event.port));
@@ -115,11 +116,17 @@ BaseServer::BaseServer(std::string const& name,
   this->_registry.get().add_system(
       [this](Registry& /*r*/)
       {
-        auto events = this->_event_queue.flush();
-        for (auto& evt : events) {
-          this->_event_manager.get().emit(evt.event_id, evt.data);
-        }
-      });
+        this->_event_queue.drain(
+            [this](EventBuilder& evt)
+            {
+              if (evt.local_id) {
+                this->_event_manager.get().emit(*evt.local_id, evt.data);
+              } else {
+                this->_event_manager.get().emit(evt.event_id, evt.data);
+              }
+            });
+      },
+      NETWORK_DRAIN_PRIORITY);
 
   SUBSCRIBE_EVENT(StateTransfer, {
     std::vector<ComponentState> s = this->_registry.get().get_state();
@@ -129,6 +129,8 @@ void Server::reset_client_by_endpoint(asio::ip::udp::endpoint const& client)
         true);
     // std::this_thread::sleep_for(std::chrono::milliseconds(100));
     c.acknowledge_manager.reset();
+    // The table may have been lost with the skipped packets
+    this->send_event_table(c);
     this->transmit_event_to_server(
         EventBuilder("StateTransfer", StateTransfer(c.client_id).to_bytes()));
   }
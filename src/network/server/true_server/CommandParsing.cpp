@@ -104,6 +104,21 @@ std::optional<EventBuilder> Server::parse_event_build_cmd(
   return std::get<SUCCESS>(r).value;
 }
 
+std::optional<EventIdCommand> Server::parse_event_id_build_cmd(
+    ByteArray const& package)
+{
+  Result<EventIdCommand> r = parse_event_id_cmd()(package);
+
+  if (r.index() == ERR) {
+    LOGGER_EVTLESS(LogLevel::ERR,
+                   "server",
+                   std::format("Failed to read event id command : {}",
+                               std::get<ERR>(r).message));
+    return std::nullopt;
+  }
+  return std::get<SUCCESS>(r).value;
+}
+
 std::optional<ComponentBuilder> Server::parse_component_build_cmd(
     ByteArray const& package)
 {
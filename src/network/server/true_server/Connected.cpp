@@ -1,3 +1,4 @@
+#include <chrono>
 #include <stdexcept>
 #include <vector>
 
@@ -12,6 +13,8 @@ const std::unordered_map<std::uint8_t,
                          void (Server::*)(ByteArray const&,
                                           const asio::ip::udp::endpoint&)>
     Server::connected_table = {{SENDEVENT, &Server::handle_event_receive},
+                               {SENDEVENTID, &Server::handle_event_id_receive},
+                               {EVENTTABLEACK, &Server::handle_event_table_ack},
                                {SENDHEARTHBEAT, &Server::handle_hearthbeat}};
 
 void Server::handle_connected_packet(ConnectedPackage const& command,
@@ -69,6 +72,37 @@ void Server::handle_event_receive(ByteArray const& package,
   this->transmit_event_to_server(parsed.value());
 }
 
+void Server::handle_event_id_receive(
+    ByteArray const& package, const asio::ip::udp::endpoint& /*endpoint*/)
+{
+  auto parsed = parse_event_id_build_cmd(package);
+
+  if (!parsed) {
+    return;
+  }
+  if (parsed->event_id >= this->_event_names.size()
+      || this->_event_names[parsed->event_id].empty())
+  {
+    LOGGER_EVTLESS(LogLevel::WARNING,
+                   "server",
+                   std::format("Unknown event id: {}", parsed->event_id));
+    return;
+  }
+  this->transmit_event_to_server(
+      EventBuilder(parsed->event_id, std::move(parsed->data)));
+}
+
+void Server::handle_event_table_ack(ByteArray const& /*package*/,
+                                    const asio::ip::udp::endpoint& endpoint)
+{
+  this->_client_mutex.lock();
+  try {
+    this->find_client_by_endpoint(endpoint).event_table_acked = true;
+  } catch (ClientNotFound const&) {  // NOLINT
+  }
+  this->_client_mutex.unlock();
+}
+
 void Server::handle_hearthbeat(ByteArray const& package,
                                const asio::ip::udp::endpoint& endpoint)
 {
@@ -79,6 +113,14 @@ void Server::handle_hearthbeat(ByteArray const& package,
   }
   this->_client_mutex.lock();
   auto& client = this->find_client_by_endpoint(endpoint);
+  std::size_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+  // The table or its acknowledgment was lost, the events go by name meanwhile
+  if (!client.event_table_acked
+      && now > client.event_table_sent + event_table_resend_delta)
+  {
+    this->send_event_table(client);
+  }
   auto const& packages_to_send =
       client.acknowledge_manager.get_packages_to_send(parsed->lost_packages);
   auto const& lost_packages = client.acknowledge_manager.get_lost_packages();
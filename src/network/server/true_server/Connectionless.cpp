@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <random>
 
 #include "ByteParser/ByteParser.hpp"
@@ -93,6 +94,13 @@ void Server::handle_connect(ByteArray const& cmd,
     client.client_id = client_id;
     client.player_name = parsed->player_name;
     client.state = ClientState::CONNECTED;
+
+    ByteArray pkg = type_to_byte<Byte>(CONNECTRESPONSE)
+        + type_to_byte<std::uint8_t>(client_id)
+        + type_to_byte<std::uint32_t>(_server_id);
+
+    send(pkg, sender);
+    this->send_event_table(client);
     this->_client_mutex.unlock();
 
     LOGGER_EVTLESS(LogLevel::INFO,
@@ -100,12 +108,6 @@ void Server::handle_connect(ByteArray const& cmd,
                    std::format("Player '{}' connected as client {}",
                                parsed->player_name,
                                static_cast<int>(client_id)));
-
-    ByteArray pkg = type_to_byte<Byte>(CONNECTRESPONSE)
-        + type_to_byte<std::uint8_t>(client_id)
-        + type_to_byte<std::uint32_t>(_server_id);
-
-    send(pkg, sender);
     this->transmit_event_to_server(EventBuilder(
         "NewConnection", NewConnection(client_id, user_id).to_bytes()));
   } catch (ClientNotFound const& e) {
@@ -119,6 +121,19 @@ void Server::handle_connect(ByteArray const& cmd,
   }
 }
 
+void Server::send_event_table(ClientInfo& client)
+{
+  client.event_table_acked = false;
+  client.event_table_sent =
+      std::chrono::steady_clock::now().time_since_epoch().count();
+  this->send_connected(
+      type_to_byte<Byte>(EVENTTABLE)
+          + vector_to_byte(
+              this->_event_names,
+              std::function<ByteArray(std::string const&)>(string_to_byte)),
+      client);
+}
+
 std::uint32_t Server::generate_challenge()
 {
   static std::random_device rd;
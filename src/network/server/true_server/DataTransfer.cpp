@@ -1,5 +1,8 @@
 
+#include <cstdint>
+#include <format>
 #include <iostream>
+#include <optional>
 
 #include <asio/registered_buffer.hpp>
 
@@ -7,6 +10,7 @@
 #include "NetworkShared.hpp"
 #include "network/server/Server.hpp"
 #include "plugin/Byte.hpp"
+#include "plugin/events/LogMacros.hpp"
 
 void Server::transmit_event_to_client(EventBuilderId const& to_transmit)
 {
@@ -15,7 +19,12 @@ void Server::transmit_event_to_client(EventBuilderId const& to_transmit)
 
 void Server::transmit_event_to_server(EventBuilder const& to_transmit)
 {
-  this->_events_queue_to_serv.get().push(to_transmit);
+  if (!this->_events_queue_to_serv.get().try_push(to_transmit)) {
+    LOGGER_EVTLESS(
+        LogLevel::WARNING,
+        "server",
+        std::format("Event queue full, dropping {}", to_transmit.event_id));
+  }
 }
 
 void Server::send_event_to_client()
@@ -25,11 +34,24 @@ void Server::send_event_to_client()
     auto events = this->_events_queue_to_client.get().flush();
     this->_client_mutex.lock();
     for (auto const& evt : events) {
-      ByteArray data = type_to_byte(SENDEVENT) + evt.event.to_bytes();
+      std::optional<ByteArray> by_id = this->encode_event_id(evt.event);
+      std::optional<ByteArray> by_name;
+      // By name until the client acknowledged the event table
+      auto data = [&](ClientInfo const& client) -> ByteArray const&
+      {
+        if (by_id && client.event_table_acked) {
+          return *by_id;
+        }
+        if (!by_name) {
+          by_name = this->encode_event_name(evt.event);
+        }
+        return *by_name;
+      };
+
       if (evt.client) {
         try {
           auto& client = this->find_client_by_id(*evt.client);
-          this->send_connected(data, client);
+          this->send_connected(data(client), client);
         } catch (ClientNotFound const& e) {
           LOGGER_EVTLESS(
               LogLevel::WARNING,
@@ -43,7 +65,7 @@ void Server::send_event_to_client()
           if (it.state != ClientState::CONNECTED) {
             continue;
           }
-          this->send_connected(data, it);
+          this->send_connected(data(it), it);
         }
       }
     }
@@ -51,6 +73,38 @@ void Server::send_event_to_client()
   }
 }
 
+std::optional<ByteArray> Server::encode_event_id(
+    EventBuilder const& event) const
+{
+  std::optional<std::uint32_t> id;
+
+  if (event.local_id && *event.local_id < this->_event_names.size()
+      && !this->_event_names[*event.local_id].empty())
+  {
+    id = static_cast<std::uint32_t>(*event.local_id);
+  } else if (auto it = this->_event_ids.find(event.event_id);
+             it != this->_event_ids.end())
+  {
+    id = it->second;
+  }
+  if (!id) {
+    // Registered after launch, the clients only know it by name
+    return std::nullopt;
+  }
+  return type_to_byte<Byte>(SENDEVENTID) + type_to_byte(*id) + event.data;
+}
+
+ByteArray Server::encode_event_name(EventBuilder const& event) const
+{
+  if (event.event_id.empty() && event.local_id
+      && *event.local_id < this->_event_names.size())
+  {
+    return type_to_byte<Byte>(SENDEVENT)
+        + string_to_byte(this->_event_names[*event.local_id]) + event.data;
+  }
+  return type_to_byte<Byte>(SENDEVENT) + event.to_bytes();
+}
+
 void Server::send_comp()
 {
   while (this->_running) {
@@ -26,15 +26,23 @@
 Server::Server(ServerLaunching const& s,
                SharedQueue<ComponentBuilderId>& comp_queue,
                SharedQueue<EventBuilderId>& event_to_client,
-               SharedQueue<EventBuilder>& event_to_server,
-               std::atomic<bool>& running)
+               MpscRing<EventBuilder>& event_to_server,
+               std::atomic<bool>& running,
+               std::vector<std::string> event_names)
     : _server_endpoint(asio::ip::udp::endpoint(asio::ip::udp::v4(), s.port))
     , _socket(_io_c, _server_endpoint)
     , _components_to_create(std::ref(comp_queue))
     , _events_queue_to_client(std::ref(event_to_client))
     , _events_queue_to_serv(std::ref(event_to_server))
+    , _event_names(std::move(event_names))
     , _running(running)
 {
+  for (std::size_t i = 0; i < this->_event_names.size(); i++) {
+    if (!this->_event_names[i].empty()) {
+      this->_event_ids.try_emplace(this->_event_names[i],
+                                   static_cast<std::uint32_t>(i));
+    }
+  }
   this->_queue_readers.emplace_back([this]() { this->send_comp(); });
   this->_queue_readers.emplace_back([this]() { this->send_event_to_client(); });
   std::random_device rd;
@@ -54,7 +62,6 @@ void Server::close()
 Server::~Server()
 {
   this->_events_queue_to_client.get().release();
-  this->_events_queue_to_serv.get().release();
   this->_components_to_create.get().release();
   for (auto& it : this->_queue_readers) {
     if (it.joinable()) {
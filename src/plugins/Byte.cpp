@@ -2,6 +2,7 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -23,7 +24,7 @@ ByteArray& operator+=(ByteArray& first, ByteArray const& second)
   return first;
 }
 
-ByteArray string_to_byte(std::string const& str)
+ByteArray string_to_byte(std::string_view str)
 {
   return type_to_byte<uint32_t>(str.size()) + ByteArray(str.begin(), str.end());
 }
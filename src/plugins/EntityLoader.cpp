@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -125,13 +126,17 @@ void EntityLoader::load_scene(JsonObject& json_scene)
   if (json_scene.contains("entities")) {
     JsonArray const& array =
         std::get<JsonArray>(json_scene.at("entities").value);
-    for (auto const& it : array) {
-      std::optional<Ecs::Entity> new_e =
-          this->load_entity(std::get<JsonObject>(it.value));
-      if (new_e.has_value()) {
-        this->_registry.get().add_component(new_e.value(), Scene(scene));
-      }
+    std::vector<Ecs::Entity> entities =
+        this->_registry.get().spawn_entities(array.size());
+
+    for (std::size_t i = 0; i < array.size(); i++) {
+      this->load_components(entities[i],
+                            std::get<JsonObject>(array[i].value));
     }
+    std::pmr::vector<Scene> scenes(entities.size(),
+                                   Scene(scene),
+                                   &this->_registry.get().memory_resource());
+    this->_registry.get().add_components<Scene>(entities, scenes);
   }
 }
 
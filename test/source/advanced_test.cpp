@@ -1,10 +1,14 @@
+#include <atomic>
 #include <chrono>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
 #include "Clock.hpp"
 #include "TwoWayMap.hpp"
+#include "ecs/ThreadPool.hpp"
 
 TEST_CASE("TwoWayMap - bidirectional lookup", "[twowaymap]")
 {
@@ -67,6 +71,37 @@ TEST_CASE("TwoWayMap - overwrites update forward mapping", "[twowaymap]")
   // This is a known limitation of the current implementation
 }
 
+TEST_CASE("ThreadPool - runs every index once", "[thread_pool]")
+{
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> hits(1000);
+
+  for (int round = 0; round < 10; round++) {
+    pool.run(hits.size(), [&hits](std::size_t i) { hits[i]++; });
+  }
+
+  for (auto const& hit : hits) {
+    REQUIRE(hit == 10);
+  }
+}
+
+TEST_CASE("ThreadPool - rethrows task exceptions", "[thread_pool]")
+{
+  ThreadPool pool(2);
+  std::atomic<int> runs = 0;
+
+  REQUIRE_THROWS_AS(pool.run(100,
+                             [&runs](std::size_t i)
+                             {
+                               runs++;
+                               if (i == 42) {
+                                 throw std::runtime_error("boom");
+                               }
+                             }),
+                    std::runtime_error);
+  REQUIRE(runs == 100);
+}
+
 TEST_CASE("Clock - delta_seconds increases over time", "[clock]")
 {
   Clock clock;
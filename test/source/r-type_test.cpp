@@ -1,17 +1,109 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "NetworkShared.hpp"
 #include "TwoWayMap.hpp"
+#include "ecs/CommandBuffer.hpp"
 #include "ecs/EventManager.hpp"
+#include "ecs/EventStats.hpp"
 #include "ecs/Registry.hpp"
 #include "ecs/SparseArray.hpp"
+#include "ecs/zipper/Group.hpp"
+#include "ecs/zipper/Query.hpp"
+#include "ecs/zipper/ZipperIndex.hpp"
 #include "plugin/Byte.hpp"
+#include "plugin/TransformHierarchy.hpp"
+#include "plugin/components/AnimatedSprite.hpp"
 #include "plugin/components/Direction.hpp"
 #include "plugin/components/Health.hpp"
 #include "plugin/components/Position.hpp"
 #include "plugin/components/Speed.hpp"
+#include "plugin/events/CollisionEvent.hpp"
+#include "plugin/events/EventMacros.hpp"
+
+namespace
+{
+/// Data-free components, stored as bitsets
+struct Frozen
+{
+  Frozen() = default;
+
+  explicit Frozen(ByteArray const& /*unused*/) {}
+
+  ByteArray to_bytes() const { return {}; }
+
+  CHANGE_ENTITY_DEFAULT
+};
+
+struct Boss
+{
+  Boss() = default;
+
+  explicit Boss(ByteArray const& /*unused*/) {}
+
+  ByteArray to_bytes() const { return {}; }
+
+  CHANGE_ENTITY_DEFAULT
+};
+
+/// Data-free event
+struct Ping
+{
+  Ping() = default;
+  EMPTY_BYTE_CONSTRUCTOR(Ping)
+  DEFAULT_SERIALIZE(ByteArray {})
+
+  CHANGE_ENTITY_DEFAULT
+
+  Ping(Registry&, JsonObject const&, std::optional<Ecs::Entity>) {}
+};
+
+/// One distinct event type per N, to assign many ids
+template<std::size_t N>
+struct Numbered : Ping
+{
+  Numbered() = default;
+  EMPTY_BYTE_CONSTRUCTOR(Numbered)
+};
+
+/// Counts the bytes currently allocated through it
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  std::size_t in_use = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override
+  {
+    this->in_use += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+  {
+    this->in_use -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(std::pmr::memory_resource const& other) const
+      noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace
 
 TEST_CASE("SparseArray - Basic construction", "[sparse_array]")
 {
@@ -111,6 +203,109 @@ TEST_CASE("SparseArray - get_index throws when not found", "[sparse_array]")
   REQUIRE(arr[0]->pos.y == 20.0f);
 }
 
+TEST_CASE("SparseArray - erase keeps other elements reachable",
+          "[sparse_array]")
+{
+  SparseArray<Position> arr;
+  arr.insert_at(2, Position(2.0f, 0.0f));
+  arr.insert_at(7, Position(7.0f, 0.0f));
+  arr.insert_at(4, Position(4.0f, 0.0f));
+
+  arr.erase(2);
+
+  REQUIRE(arr.count() == 2);
+  REQUIRE(!arr[2].has_value());
+  REQUIRE(arr[7]->pos.x == 7.0f);
+  REQUIRE(arr[4]->pos.x == 4.0f);
+}
+
+TEST_CASE("SparseArray - misses do not share state between threads",
+          "[sparse_array]")
+{
+  SparseArray<Position> arr;
+  arr.insert_at(1, Position(1.0f, 0.0f));
+
+  arr[9] = Position(9.0f, 0.0f);
+  REQUIRE(!arr[9].has_value());
+  REQUIRE(!arr.contains(9));
+
+  SparseArray<Position>::Value* main_miss = &arr[9];
+  SparseArray<Position>::Value* worker_miss = nullptr;
+
+  std::thread([&]() { worker_miss = &arr.modify(9); }).join();
+  REQUIRE(worker_miss != main_miss);
+}
+
+TEST_CASE("SparseArray - iteration only visits live components",
+          "[sparse_array]")
+{
+  SparseArray<Position> arr;
+  arr.insert_at(3, Position(3.0f, 0.0f));
+  arr.insert_at(5000, Position(5000.0f, 0.0f));
+
+  std::size_t visited = 0;
+  for (auto const& pos : arr) {
+    REQUIRE(pos.has_value());
+    visited++;
+  }
+
+  REQUIRE(visited == 2);
+  REQUIRE(arr.size() == 5001);
+  REQUIRE(arr.entities().size() == 2);
+  REQUIRE(!arr[4999].has_value());
+  REQUIRE(!arr[100000].has_value());
+}
+
+TEST_CASE("SparseArray - allocates from its memory resource",
+          "[sparse_array]")
+{
+  CountingResource resource;
+  {
+    SparseArray<Position> arr(&resource);
+
+    std::size_t page_bytes =
+        SparseArray<Position>::page_size * sizeof(std::size_t);
+
+    arr.insert_at(3, Position(3.0f, 0.0f));
+    REQUIRE(resource.in_use >= page_bytes);
+
+    arr.insert_at(5000, Position(5000.0f, 0.0f));
+    std::size_t two_pages = resource.in_use;
+    arr.erase(5000);
+    REQUIRE(resource.in_use == two_pages - page_bytes);
+
+    SparseArray<Position> copy = arr;
+    REQUIRE(copy[3]->pos.x == 3.0f);
+
+    // Entity ids and change ticks come from the resource too
+    std::size_t before = resource.in_use;
+    arr.reserve(64);
+    REQUIRE(resource.in_use - before
+            >= 63 * (sizeof(std::size_t) + 2 * sizeof(ChangeTick)));
+
+    // Allocator-aware components are copied into the resource
+    SparseArray<Scene> scenes(&resource);
+    std::string name(64, 'a');
+    before = resource.in_use;
+    scenes.insert_at(1, Scene(name));
+    REQUIRE(resource.in_use - before >= name.size());
+    REQUIRE(scenes[1]->scene_name.get_allocator().resource() == &resource);
+
+    SparseArray<AnimatedSprite> sprites(&resource);
+    AnimatedSprite::Animations animations;
+    animations.emplace("idle", AnimationData());
+    before = resource.in_use;
+    sprites.insert_at(1, AnimatedSprite(animations, "idle", "idle"));
+    REQUIRE(resource.in_use - before >= sizeof(AnimationData));
+    REQUIRE(sprites[1]->animations.get_allocator().resource() == &resource);
+  }
+  REQUIRE(resource.in_use == 0);
+
+  Registry reg;
+  reg.register_component<Position>("position");
+  REQUIRE(&reg.memory_resource() != std::pmr::get_default_resource());
+}
+
 TEST_CASE("Registry - spawn_entity creates unique entities", "[registry]")
 {
   Registry reg;
@@ -145,6 +340,33 @@ TEST_CASE("Registry - getComponents retrieves registered components",
   REQUIRE(positions.empty());
 }
 
+TEST_CASE("Registry - component ids are stable and per registry",
+          "[registry]")
+{
+  Registry first;
+  first.register_component<Position>("Position");
+  first.register_component<Speed>("Speed");
+
+  Registry second;
+  second.register_component<Speed>("Speed");
+  second.register_component<Position>("Position");
+
+  REQUIRE(first.component_id<Position>() == 0);
+  REQUIRE(first.component_id<Speed>() == 1);
+  REQUIRE(second.component_id<Position>() == 1);
+  REQUIRE(second.component_id<Speed>() == 0);
+
+  Entity e = first.spawn_entity();
+  first.add_component(e, Position(1.0f, 2.0f));
+  REQUIRE(first.has_component<Position>(e));
+  REQUIRE_FALSE(second.has_component<Position>(e));
+
+  first.register_component<Position>("Position");
+  REQUIRE(first.component_id<Position>() == 0);
+  REQUIRE(first.get_components<Position>().empty());
+  REQUIRE_THROWS_AS(first.get_components<Direction>(), std::out_of_range);
+}
+
 TEST_CASE("Registry - add_component adds component to entity", "[registry]")
 {
   Registry reg;
@@ -210,6 +432,191 @@ TEST_CASE("Registry - kill_entity recycles entity IDs", "[registry]")
   REQUIRE(entity3 == entity1);
 }
 
+TEST_CASE("Registry - spawn_entities and add_components work in batches",
+          "[registry]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  std::vector<Entity> first = reg.spawn_entities(4);
+  REQUIRE(first == std::vector<Entity> {0, 1, 2, 3});
+
+  reg.kill_entity(first[1]);
+  reg.process_entity_deletions();
+  std::vector<Entity> second = reg.spawn_entities(3);
+  REQUIRE(second == std::vector<Entity> {1, 4, 5});
+  REQUIRE(reg.spawn_entity() == 6);
+
+  std::vector<Position> positions;
+  for (Entity e : second) {
+    positions.emplace_back(static_cast<float>(e), 0.0f);
+  }
+  reg.add_components<Position>(second, positions);
+  std::vector<Speed> speeds(2, Speed(1.0f, 0.0f));
+  reg.add_components<Speed>(std::span(second).first(2), speeds);
+
+  REQUIRE(reg.get_components<Position>().count() == 3);
+  REQUIRE(reg.get_components<Position>()[5]->pos.x == 5.0);
+  REQUIRE(reg.has_component<Speed>(4));
+  REQUIRE_FALSE(reg.has_component<Speed>(5));
+  REQUIRE(reg.query<Position const, Speed const>().count() == 2);
+  REQUIRE_THROWS_AS(reg.add_components<Speed>(second, speeds),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Registry - low id reuse and shrink_to_fit reclaim memory",
+          "[registry]")
+{
+  Registry reg;
+  auto& positions = reg.register_component<Position>("Position");
+  reg.set_id_reuse(IdReusePolicy::LOWEST_FIRST);
+
+  std::vector<Entity> entities = reg.spawn_entities(3000);
+  for (Entity e : entities) {
+    reg.add_component(e, Position(0.0f, 0.0f));
+  }
+  REQUIRE(positions.allocated_pages() == 3);
+
+  for (Entity e = 500; e < 3000; e++) {
+    reg.kill_entity(e);
+  }
+  reg.kill_entity(7);
+  reg.process_entity_deletions();
+  REQUIRE(positions.count() == 499);
+  REQUIRE(positions.allocated_pages() == 1);
+
+  REQUIRE(reg.spawn_entity() == 7);
+  REQUIRE(reg.spawn_entity() == 500);
+
+  reg.shrink_to_fit();
+  REQUIRE(positions.size() <= SparseArray<Position>::page_size);
+  REQUIRE(reg.spawn_entity() == 501);
+  REQUIRE(reg.spawn_entity() == 502);
+  REQUIRE(positions[3].has_value());
+}
+
+TEST_CASE("Registry - snapshot and restore roll the world back",
+          "[registry]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.add_scene("game", SceneState::ACTIVE);
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  std::vector<Entity> entities = reg.spawn_entities(4);
+  for (Entity e : entities) {
+    reg.add_component(e, Position(static_cast<float>(e), 0.0f));
+  }
+  reg.add_component(entities[1], Speed(1.0f, 0.0f));
+  reg.add_component(entities[2], Scene("game"));
+  std::size_t moving = reg.query<Position, Speed>().count();
+
+  RegistrySnapshot snap = reg.snapshot();
+  REQUIRE_FALSE(snap.empty());
+
+  reg.get_components<Position>()[0]->pos.x = 42.0;
+  reg.add_component(entities[3], Speed(2.0f, 0.0f));
+  reg.remove_component<Scene>(entities[2]);
+  reg.kill_entity(entities[1]);
+  reg.process_entity_deletions();
+  Entity extra = reg.spawn_entity();
+  reg.add_component(extra, Position(9.0f, 9.0f));
+  REQUIRE(reg.query<Position, Speed>().count() == 1);
+
+  reg.restore(snap);
+  REQUIRE(reg.get_components<Position>()[0]->pos.x == 0.0);
+  REQUIRE(reg.get_components<Position>().count() == 4);
+  REQUIRE(reg.has_component<Speed>(entities[1]));
+  REQUIRE_FALSE(reg.has_component<Speed>(entities[3]));
+  REQUIRE(reg.get_components<Scene>()[entities[2]]->scene_name == "game");
+  REQUIRE(reg.query<Position, Speed>().count() == moving);
+  REQUIRE(reg.query<Position, Speed>().entities()
+          == std::vector<Entity> {entities[1]});
+  REQUIRE(reg.spawn_entity() == 4);
+
+  reg.snapshot(snap);
+  reg.restore(snap);
+  REQUIRE(reg.get_components<Position>().count() == 4);
+
+  Registry other;
+  REQUIRE_THROWS_AS(other.restore(snap), std::invalid_argument);
+}
+
+TEST_CASE("Registry - stats report counts and memory per storage",
+          "[registry]")
+{
+  Registry reg;
+  reg.register_component<Position>("moving:Position");
+  reg.register_component<Frozen>("frozen");
+
+  std::vector<Ecs::Entity> entities = reg.spawn_entities(10);
+  for (Ecs::Entity e : entities) {
+    reg.add_component(e, Position(1.0f, 2.0f));
+  }
+  reg.add_component(entities[0], Frozen {});
+  reg.kill_entity(entities[9]);
+  reg.process_entity_deletions();
+
+  RegistryStats stats = reg.stats();
+  REQUIRE(stats.live_entities == 9);
+  REQUIRE(stats.dead_ids == 1);
+  REQUIRE(stats.entity_ids == 10);
+  REQUIRE(stats.components.size() == 2);
+
+  ComponentStats const& pos =
+      stats.components[reg.component_id<Position>()];
+  REQUIRE(pos.name == "moving:Position");
+  REQUIRE(pos.live == 9);
+  REQUIRE(pos.capacity >= 9);
+  REQUIRE(pos.storage_bytes
+          >= SparseArray<Position>::page_size * sizeof(std::size_t));
+  REQUIRE(pos.serialized_bytes == 0);
+  REQUIRE_FALSE(pos.tag);
+
+  ComponentStats const& frozen = stats.components[reg.component_id<Frozen>()];
+  REQUIRE(frozen.tag);
+  REQUIRE(frozen.live == 1);
+  REQUIRE(stats.component_bytes() >= pos.storage_bytes);
+}
+
+TEST_CASE("Registry - process_entity_deletions erases owned components",
+          "[registry]")
+{
+  Registry reg;
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+  reg.register_component<Health>("Health");
+
+  auto dying = reg.spawn_entity();
+  auto kept = reg.spawn_entity();
+  reg.add_component(dying, Position(1.0f, 1.0f));
+  reg.emplace_component<Speed>(dying, 2.0, 0.0);
+  reg.add_component(kept, Position(3.0f, 3.0f));
+  reg.add_component(kept, Health(10, 10));
+  reg.remove_component<Health>(kept);
+  reg.add_component(kept, Health(5, 10));
+
+  reg.kill_entity(dying);
+  reg.process_entity_deletions();
+
+  REQUIRE_FALSE(reg.has_component<Position>(dying));
+  REQUIRE_FALSE(reg.has_component<Speed>(dying));
+  REQUIRE(reg.has_component<Position, Health>(kept));
+
+  auto recycled = reg.spawn_entity();
+  REQUIRE(recycled == dying);
+  reg.add_component(recycled, Health(1, 1));
+  reg.kill_entity(recycled);
+  reg.kill_entity(kept);
+  reg.process_entity_deletions();
+
+  REQUIRE(reg.get_components<Position>().empty());
+  REQUIRE(reg.get_components<Health>().empty());
+}
+
 TEST_CASE("Registry - multiple components per entity", "[registry]")
 {
   Registry reg;
@@ -256,6 +663,1134 @@ TEST_CASE("Registry - add_system and runSystems", "[registry]")
   REQUIRE(system_runs == 2);
 }
 
+TEST_CASE("Registry - system handles enable, disable and remove systems",
+          "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.add_scene("menu", SceneState::DISABLED);
+
+  int first_runs = 0;
+  int added_runs = 0;
+  int menu_runs = 0;
+  SystemId added = 0;
+
+  SystemId first = reg.add_system(
+      [&](Registry& r)
+      {
+        first_runs++;
+        if (first_runs == 1) {
+          added = r.add_system([&added_runs](Registry&) { added_runs++; });
+        }
+      },
+      1);
+  SystemId menu = reg.add_system([&menu_runs](Registry&) { menu_runs++; });
+  reg.bind_system_to_scene(menu, "menu");
+
+  reg.run_systems(event_manager);
+  REQUIRE(first_runs == 1);
+  REQUIRE(added_runs == 0);
+  REQUIRE(menu_runs == 0);
+  REQUIRE(reg.is_system_enabled(added));
+  REQUIRE(reg.stats().systems == 3);
+
+  reg.activate_scene("menu");
+  reg.run_systems(event_manager);
+  REQUIRE(added_runs == 1);
+  REQUIRE(menu_runs == 1);
+
+  reg.disable_system(first);
+  REQUIRE_FALSE(reg.is_system_enabled(first));
+  reg.run_systems(event_manager);
+  REQUIRE(first_runs == 2);
+
+  reg.enable_system(first);
+  reg.remove_system(added);
+  reg.run_systems(event_manager);
+  REQUIRE(first_runs == 3);
+  REQUIRE(added_runs == 2);
+  REQUIRE_FALSE(reg.is_system_enabled(added));
+}
+
+TEST_CASE("Registry - concurrent systems keep conflicting systems ordered",
+          "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  auto entity = reg.spawn_entity();
+  reg.add_component(entity, Position(0.0f, 0.0f));
+  reg.add_component(entity, Speed(1.0f, 0.0f));
+
+  std::vector<double> seen;
+  std::atomic<int> speed_runs = 0;
+
+  reg.add_concurrent_system<Position, Speed const>(
+      [entity](Registry&,
+               SparseArray<Position>& positions,
+               SparseArray<Speed> const& speeds)
+      { positions[entity]->pos.x += speeds[entity]->speed.x; },
+      1);
+  reg.add_concurrent_system<Position const>(
+      [entity, &seen](Registry&, SparseArray<Position> const& positions)
+      { seen.push_back(positions[entity]->pos.x); },
+      1);
+  reg.add_concurrent_system<Speed const>(
+      [&speed_runs](Registry&, SparseArray<Speed> const&) { speed_runs++; },
+      1);
+
+  reg.run_systems(event_manager);
+  reg.run_systems(event_manager);
+
+  REQUIRE(seen == std::vector<double> {1.0, 2.0});
+  REQUIRE(speed_runs == 2);
+}
+
+TEST_CASE("Registry - a batch sees the components its siblings recorded",
+          "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  auto entity = reg.spawn_entity();
+  reg.add_component(entity, Position(0.0f, 0.0f));
+
+  bool recorded = false;
+  std::vector<std::vector<std::size_t>> added;
+
+  reg.add_concurrent_system<Position const>(
+      [&recorded](Registry& r, SparseArray<Position> const& positions)
+      {
+        if (recorded) {
+          return;
+        }
+        for (std::size_t e : positions.entities()) {
+          r.commands().add(e, Speed(1.0f, 0.0f));
+        }
+        recorded = true;
+      },
+      1);
+  reg.add_concurrent_system<Speed const>(
+      [&added](Registry& r, SparseArray<Speed> const&)
+      {
+        std::vector<std::size_t> frame;
+        for (auto&& [e, speed] : ZipperIndex<Added<Speed const>>(r)) {
+          frame.push_back(e);
+        }
+        added.push_back(frame);
+      },
+      1);
+
+  for (std::size_t i = 0; i < 3; i++) {
+    reg.run_systems(event_manager);
+  }
+
+  REQUIRE(added.size() == 3);
+  REQUIRE(added[0].empty());
+  REQUIRE(added[1] == std::vector<std::size_t> {entity});
+  REQUIRE(added[2].empty());
+}
+
+#ifndef NDEBUG
+TEST_CASE("Registry - concurrent systems only reach declared storages",
+          "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  auto entity = reg.spawn_entity();
+  reg.add_component(entity, Position(0.0f, 0.0f));
+  reg.add_component(entity, Speed(1.0f, 0.0f));
+
+  auto declared = reg.add_concurrent_system<Position>(
+      [](Registry& r, SparseArray<Position>&)
+      {
+        for (auto&& [pos] : Zipper<Position>(r)) {
+          pos.pos.x += 1.0;
+        }
+      });
+  REQUIRE_NOTHROW(reg.run_systems(event_manager));
+
+  reg.remove_system(declared);
+  reg.add_concurrent_system<Position>(
+      [](Registry& r, SparseArray<Position>&) { r.get_components<Speed>(); });
+  REQUIRE_THROWS_AS(reg.run_systems(event_manager), std::logic_error);
+}
+#endif
+
+TEST_CASE("ZipperIndex - visits only entities owning every component",
+          "[zipper]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  for (std::size_t i = 0; i < 100; i++) {
+    reg.add_component(reg.spawn_entity(), Position(1.0f, 1.0f));
+  }
+  reg.add_component(Entity(10), Speed(1.0f, 0.0f));
+  reg.add_component(Entity(42), Speed(1.0f, 0.0f));
+  reg.add_component(Entity(500), Speed(1.0f, 0.0f));
+
+  std::vector<std::size_t> visited;
+  for (auto&& [e, pos, speed] : ZipperIndex<Position, Speed>(reg)) {
+    visited.push_back(e);
+  }
+
+  std::ranges::sort(visited);
+  REQUIRE(visited == std::vector<std::size_t> {10, 42});
+}
+
+TEST_CASE("ZipperIndex - par_each visits every entity and defers in order",
+          "[zipper]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  for (std::size_t i = 0; i < 5000; i++) {
+    auto entity = reg.spawn_entity();
+    reg.add_component(entity, Position(0.0f, 0.0f));
+    if (i % 3 != 0) {
+      reg.add_component(entity, Speed(1.0f, 0.0f));
+    }
+  }
+
+  std::vector<std::size_t> deferred;
+  ZipperIndex<Position, Speed const>(reg).par_each(
+      [&reg, &deferred](
+          std::size_t e, Position& pos, Speed const& speed)
+      {
+        pos.pos.x += speed.speed.x;
+        reg.defer([&deferred, e]() { deferred.push_back(e); });
+      });
+
+  std::vector<std::size_t> expected;
+  for (auto&& [e, pos, speed] : ZipperIndex<Position, Speed>(reg)) {
+    REQUIRE(pos.pos.x == 1.0);
+    expected.push_back(e);
+  }
+  REQUIRE(deferred == expected);
+  REQUIRE(expected.size() == 3333);
+}
+
+TEST_CASE("CommandBuffer - applies recorded changes in order", "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  for (std::size_t i = 0; i < 1000; i++) {
+    auto entity = reg.spawn_entity();
+    reg.add_component(entity, Position(0.0f, 0.0f));
+    reg.add_component(entity, Speed(1.0f, 0.0f));
+  }
+
+  std::vector<std::size_t> order;
+  ZipperIndex<Position const, Speed const>(reg).par_each(
+      [&reg, &order](std::size_t e, Position const&, Speed const&)
+      {
+        if (e % 2 == 0) {
+          reg.commands().remove<Speed>(e);
+        } else {
+          reg.commands().add(e, Position(static_cast<float>(e), 0.0f));
+        }
+        reg.commands().call([&order, e](Registry&, EventManager&)
+                            { order.push_back(e); });
+      });
+  REQUIRE(reg.commands().size() == 2000);
+  REQUIRE(reg.get_components<Speed>().size() == 1000);
+  REQUIRE(order.empty());
+
+  reg.commands().spawn(Position(-1.0f, 0.0f), Speed(2.0f, 0.0f));
+  reg.commands().kill(0);
+  reg.apply_commands(event_manager);
+
+  REQUIRE(reg.commands().empty());
+  REQUIRE(order.size() == 1000);
+  REQUIRE(std::ranges::is_sorted(order));
+  REQUIRE(reg.is_entity_dying(0));
+  REQUIRE(reg.get_components<Position>()[7]->pos.x == 7.0);
+
+  std::vector<std::size_t> moving;
+  for (auto&& [e, pos, speed] : ZipperIndex<Position, Speed>(reg)) {
+    moving.push_back(e);
+  }
+  REQUIRE(moving.size() == 501);
+  REQUIRE(reg.get_components<Position>()[moving.back()]->pos.x == -1.0);
+
+  CommandBuffer dropped;
+  dropped.add(1, Speed(3.0f, 0.0f));
+  dropped.clear();
+  dropped.apply(reg, event_manager);
+  REQUIRE(reg.get_components<Speed>()[1]->speed.x == 1.0);
+}
+
+TEST_CASE("CommandBuffer - parallel recording keeps the block count flat",
+          "[registry]")
+{
+  Registry reg;
+  EventManager event_manager;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+
+  for (std::size_t i = 0; i < 10000; i++) {
+    reg.add_component(reg.spawn_entity(), Position(0.0f, 0.0f));
+  }
+
+  std::size_t applied = 0;
+  auto frame = [&]()
+  {
+    ZipperIndex<Position const>(reg).par_each(
+        [&reg, &applied](std::size_t, Position const&)
+        {
+          reg.commands().call([&applied](Registry&, EventManager&)
+                              { applied++; });
+        });
+    reg.apply_commands(event_manager);
+  };
+
+  frame();
+  frame();
+  std::size_t blocks = reg.commands().block_count();
+  for (std::size_t i = 0; i < 50; i++) {
+    frame();
+  }
+  REQUIRE(applied == 52 * 10000);
+  REQUIRE(blocks > 0);
+  REQUIRE(reg.commands().block_count() == blocks);
+}
+
+TEST_CASE("EventManager - handlers may change while an event is dispatched",
+          "[events]")
+{
+  EventManager em;
+  std::vector<int> calls;
+  int depth = 0;
+
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                calls.push_back(1);
+                if (depth == 0) {
+                  depth++;
+                  em.on<Ping>("Ping",
+                              [&](Ping const&)
+                              {
+                                calls.push_back(3);
+                                return false;
+                              },
+                              2);
+                  em.emit<Ping>();
+                }
+                return false;
+              },
+              2);
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                calls.push_back(2);
+                return PREVENT_DEFAULT;
+              },
+              0);
+
+  // The handler added mid-dispatch waits for the outermost emit to return
+  em.emit<Ping>();
+  REQUIRE(calls == std::vector<int> {1, 1, 2, 2});
+  calls.clear();
+  em.emit<Ping>();
+  REQUIRE(calls == std::vector<int> {1, 3, 2});
+
+  calls.clear();
+  em.off_all<Ping>();
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                calls.push_back(1);
+                em.off_all<Ping>();
+                em.on<Ping>("Ping",
+                            [&](Ping const&)
+                            {
+                              calls.push_back(3);
+                              return false;
+                            });
+                return false;
+              },
+              2);
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                calls.push_back(2);
+                return false;
+              });
+
+  em.emit<Ping>();
+  REQUIRE(calls == std::vector<int> {1, 2});
+  calls.clear();
+  em.emit<Ping>();
+  REQUIRE(calls == std::vector<int> {3});
+}
+
+TEST_CASE("EventManager - queued events are delivered as one batch",
+          "[events]")
+{
+  EventManager em;
+  std::vector<std::size_t> batches;
+  std::vector<Ecs::Entity> seen;
+
+  em.enqueue<CollisionEvent>(0, 1);
+  em.on_batch<CollisionEvent>("CollisionEvent",
+                              [&](std::span<CollisionEvent const> events)
+                              {
+                                batches.push_back(events.size());
+                                return false;
+                              });
+  em.on<CollisionEvent>("CollisionEvent",
+                        [&](CollisionEvent const& event)
+                        {
+                          seen.push_back(event.a);
+                          em.enqueue<CollisionEvent>(event.a + 10, 0);
+                          return false;
+                        });
+  em.dispatch_queued<CollisionEvent>();
+  REQUIRE(batches.empty());
+
+  em.enqueue<CollisionEvent>(1, 2);
+  em.enqueue<CollisionEvent>(2, 1);
+  em.enqueue<CollisionEvent>(3, 4);
+  REQUIRE(seen.empty());
+  em.dispatch_queued<CollisionEvent>();
+  REQUIRE(batches == std::vector<std::size_t> {3});
+  REQUIRE(seen == std::vector<Ecs::Entity> {1, 2, 3});
+
+  em.dispatch_queued<CollisionEvent>();
+  REQUIRE(batches == std::vector<std::size_t> {3, 3});
+  REQUIRE(seen == std::vector<Ecs::Entity> {1, 2, 3, 11, 12, 13});
+
+  em.on_batch<CollisionEvent>("CollisionEvent",
+                              [](std::span<CollisionEvent const>)
+                              { return true; },
+                              2);
+  em.emit<CollisionEvent>(5, 6);
+  em.dispatch_queued<CollisionEvent>();
+  REQUIRE(batches == std::vector<std::size_t> {3, 3});
+  REQUIRE(seen.size() == 6);
+}
+
+TEST_CASE("EventManager - batch and per-event handlers share priorities",
+          "[events]")
+{
+  EventManager em;
+  std::vector<std::string> calls;
+  std::vector<Ecs::Entity> low_seen;
+
+  em.enable_stats();
+  em.on<CollisionEvent>("CollisionEvent",
+                        [&](CollisionEvent const& event)
+                        {
+                          calls.push_back("high");
+                          return event.a == 2;
+                        },
+                        3);
+  em.on_batch<CollisionEvent>(
+      "CollisionEvent",
+      [&](EventBatch<CollisionEvent> const& batch)
+      {
+        calls.push_back("batch");
+        REQUIRE(batch.size() == 3);
+        for (std::size_t i = 0; i < batch.size(); i++) {
+          if (batch[i].a == 3) {
+            batch.prevent_default(i);
+          }
+        }
+        return false;
+      },
+      2);
+  em.on<CollisionEvent>("CollisionEvent",
+                        [&](CollisionEvent const& event)
+                        {
+                          low_seen.push_back(event.a);
+                          return false;
+                        },
+                        1);
+
+  for (Ecs::Entity a = 1; a <= 4; a++) {
+    em.enqueue<CollisionEvent>(a, 0);
+  }
+  em.dispatch_queued<CollisionEvent>();
+  REQUIRE(calls
+          == std::vector<std::string> {
+              "high", "high", "high", "high", "batch"});
+  REQUIRE(low_seen == std::vector<Ecs::Entity> {1, 4});
+
+  EventTypeStats const& evt =
+      em.stats().events.at(em.event_id<CollisionEvent>());
+  REQUIRE(evt.prevented == 2);
+  REQUIRE(evt.handlers.at(1).batch);
+  REQUIRE(evt.handlers.at(0).priority == 3);
+}
+
+TEST_CASE("EventManager - event names are interned to ids", "[events]")
+{
+  Registry reg;
+  EventManager em;
+  int pings = 0;
+
+  REQUIRE_FALSE(em.find_event_id("Ping").has_value());
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                pings++;
+                return false;
+              });
+
+  std::optional<EventTypeId> id = em.find_event_id("Ping");
+
+  REQUIRE(id.has_value());
+  REQUIRE(*id == em.event_id<Ping>());
+  REQUIRE(em.event_name(*id) == "Ping");
+  REQUIRE(em.event_names().at(*id) == "Ping");
+
+  em.emit(*id, ByteArray {});
+  em.emit(reg, *id, JsonObject {});
+  em.emit("Ping", ByteArray {});
+  REQUIRE(pings == 3);
+
+  em.emit(*id + 100, ByteArray {});
+  REQUIRE(pings == 3);
+
+  em.delete_all();
+  em.emit(*id, ByteArray {});
+  REQUIRE(pings == 3);
+  REQUIRE(em.find_event_id("Ping") == id);
+}
+
+TEST_CASE("EventManager - ids assigned by a running handler keep entries",
+          "[events]")
+{
+  EventManager em;
+  EventTypeId id = em.event_id<Ping>();
+  std::string const* name = nullptr;
+
+  em.on<Ping>("Ping",
+              [&](Ping const&)
+              {
+                // Like a plugin loaded from a handler registering its events
+                [&em]<std::size_t... N>(std::index_sequence<N...>)
+                { (em.event_id<Numbered<N>>(), ...); }(
+                    std::make_index_sequence<64>());
+                return false;
+              });
+  name = &em.event_name(id);
+  em.emit(id, ByteArray {});
+  REQUIRE(em.event_id<Numbered<63>>() > id + 63);
+  REQUIRE(&em.event_name(id) == name);
+  REQUIRE(*name == "Ping");
+}
+
+TEST_CASE("EventManager - stats count emissions and time handlers",
+          "[events]")
+{
+  EventManager em;
+  int calls = 0;
+
+  em.on<Ping>(
+      "Ping",
+      [&](Ping const&) { return ++calls % 2 == 0; },
+      2,
+      "first");
+  em.on<Ping>("Ping", [](Ping const&) { return false; }, 1, "second");
+  em.emit<Ping>();
+  REQUIRE(em.stats().events.at(0).emitted == 0);
+
+  em.enable_stats();
+  em.emit<Ping>();
+  em.emit<Ping>();
+  em.emit<Ping>();
+
+  EventStats stats = em.stats();
+  EventTypeStats const& ping = stats.events.at(0);
+
+  REQUIRE(stats.enabled);
+  REQUIRE(ping.name == "Ping");
+  REQUIRE(ping.id == em.event_id<Ping>());
+  REQUIRE(ping.emitted == 3);
+  REQUIRE(ping.dispatches == 3);
+  REQUIRE(ping.prevented == 2);
+  REQUIRE(ping.dispatch_time.count == 3);
+  REQUIRE(ping.handlers.size() == 2);
+  REQUIRE(ping.handlers[0].owner == "first");
+  REQUIRE(ping.handlers[0].time.count == 3);
+  REQUIRE(ping.handlers[0].prevented == 2);
+  REQUIRE(ping.handlers[1].owner == "second");
+  REQUIRE(ping.handlers[1].time.count == 1);
+
+  em.reset_stats();
+  REQUIRE(em.stats().events.at(0).emitted == 0);
+  REQUIRE(em.stats().events.at(0).handlers.size() == 2);
+
+  LatencyHistogram histogram;
+
+  for (int i = 0; i < 99; i++) {
+    histogram.record(std::chrono::nanoseconds(1000));
+  }
+  histogram.record(std::chrono::milliseconds(1));
+  REQUIRE(histogram.percentile(0.99) == 1023);
+  REQUIRE(histogram.percentile(1.0) == 1'000'000);
+  REQUIRE(histogram.max_ns == 1'000'000);
+}
+
+TEST_CASE("MpscRing - producers push while the consumer drains",
+          "[network]")
+{
+  MpscRing<std::size_t> ring(4);
+  std::vector<std::size_t> drained;
+
+  REQUIRE(ring.capacity() == 4);
+  for (std::size_t i = 0; i < 4; i++) {
+    REQUIRE(ring.try_push(i));
+  }
+  REQUIRE_FALSE(ring.try_push(4));
+  REQUIRE(ring.drain([&](std::size_t& v) { drained.push_back(v); }) == 4);
+  REQUIRE(drained == std::vector<std::size_t> {0, 1, 2, 3});
+  REQUIRE(ring.try_push(4));
+  REQUIRE(ring.drain([](std::size_t&) {}) == 1);
+
+  constexpr std::size_t producers = 4;
+  constexpr std::size_t per_producer = 20000;
+  MpscRing<std::size_t> shared(256);
+  std::vector<std::size_t> last(producers, 0);
+  std::size_t received = 0;
+  std::vector<std::thread> threads;
+
+  for (std::size_t p = 0; p < producers; p++) {
+    threads.emplace_back(
+        [&shared, p]()
+        {
+          for (std::size_t i = 1; i <= per_producer; i++) {
+            while (!shared.try_push(p * per_producer + i)) {
+              std::this_thread::yield();
+            }
+          }
+        });
+  }
+  while (received < producers * per_producer) {
+    received += shared.drain(
+        [&](std::size_t& v)
+        {
+          std::size_t p = (v - 1) / per_producer;
+
+          // Values of one producer arrive in push order
+          REQUIRE(v > last[p]);
+          last[p] = v;
+        });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  REQUIRE(received == producers * per_producer);
+}
+
+TEST_CASE("MpscRing - push waits for the consumer instead of dropping",
+          "[network]")
+{
+  constexpr std::size_t count = 10000;
+  MpscRing<std::size_t> ring(16);
+  std::atomic<bool> running = true;
+  std::vector<std::size_t> drained;
+  bool pushed_all = true;
+
+  std::thread producer(
+      [&]()
+      {
+        for (std::size_t i = 0; i < count; i++) {
+          pushed_all = ring.push(std::size_t(i), running) && pushed_all;
+        }
+      });
+  while (drained.size() < count) {
+    ring.drain([&](std::size_t& v) { drained.push_back(v); });
+  }
+  producer.join();
+  REQUIRE(pushed_all);
+  REQUIRE(drained.size() == count);
+  for (std::size_t i = 0; i < count; i++) {
+    REQUIRE(drained[i] == i);
+  }
+
+  // Full ring and shutdown: the wait ends, the value is not pushed
+  for (std::size_t i = 0; i < ring.capacity(); i++) {
+    REQUIRE(ring.try_push(i));
+  }
+  running = false;
+  REQUIRE_FALSE(ring.push(std::size_t(0), running));
+}
+
+TEST_CASE("Zipper - Changed and Added filters follow change ticks",
+          "[zipper]")
+{
+  Registry reg;
+  EventManager em;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  Entity still = reg.spawn_entity();
+  Entity moving = reg.spawn_entity();
+  reg.add_component(still, Position(0.0f, 0.0f));
+  reg.add_component(moving, Position(0.0f, 0.0f));
+  reg.add_component(moving, Speed(1.0, 0.0));
+
+  std::vector<std::vector<std::size_t>> seen;
+  std::vector<std::size_t> added;
+  reg.add_system<>(
+      [](Registry& r)
+      {
+        for (auto&& [pos, speed] : Zipper<Position, Speed const>(r)) {
+          pos.pos.x += static_cast<float>(speed.speed.x);
+        }
+      },
+      2);
+  reg.add_system<>(
+      [&seen, &added](Registry& r)
+      {
+        std::vector<std::size_t> frame;
+        for (auto&& [e, pos] : ZipperIndex<Changed<Position const>>(r)) {
+          frame.push_back(e);
+        }
+        std::ranges::sort(frame);
+        seen.push_back(frame);
+        for (auto&& [e, pos] : ZipperIndex<Added<Position const>>(r)) {
+          added.push_back(e);
+        }
+      },
+      1);
+
+  reg.run_systems(em);
+  ChangeTick between = reg.change_tick();
+  reg.run_systems(em);
+
+  REQUIRE(seen.size() == 2);
+  REQUIRE(seen[0] == std::vector<std::size_t> {still, moving});
+  REQUIRE(seen[1] == std::vector<std::size_t> {moving});
+  REQUIRE(added.size() == 2);
+
+  std::vector<std::size_t> outside;
+  for (auto&& [e, pos] : ZipperIndex<Changed<Position const>>(reg, between)) {
+    outside.push_back(e);
+  }
+  REQUIRE(outside == std::vector<std::size_t> {moving});
+  REQUIRE(reg.get_components<Position>().changed_tick(moving) >= between);
+  REQUIRE(reg.get_components<Position>().added_tick(still) < between);
+}
+
+TEST_CASE("Zipper - read-only loops leave Changed filters quiet", "[zipper]")
+{
+  Registry reg;
+  EventManager em;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+
+  for (std::size_t i = 0; i < 4; i++) {
+    reg.add_component(reg.spawn_entity(), Position(1.0f, 0.0f));
+  }
+
+  double sum = 0;
+  std::vector<std::size_t> changed;
+  reg.add_system<>(
+      [&sum](Registry& r)
+      {
+        for (auto&& [pos] : Zipper<Position const>(r)) {
+          sum += pos.pos.x;
+        }
+        for (auto&& [e, pos] : ZipperIndex<Position const>(r)) {
+          sum += pos.pos.x;
+        }
+        r.query<Position const>().each([&sum](Entity, Position const& pos)
+                                       { sum += pos.pos.x; });
+      },
+      2);
+  reg.add_system<>(
+      [&changed](Registry& r)
+      {
+        changed.clear();
+        for (auto&& [e, pos] : ZipperIndex<Changed<Position const>>(r)) {
+          changed.push_back(e);
+        }
+      },
+      1);
+
+  reg.run_systems(em);
+  REQUIRE(changed.size() == 4);
+  reg.run_systems(em);
+  REQUIRE(changed.empty());
+  REQUIRE(sum == 24.0);
+}
+
+TEST_CASE("Query - cached members follow structural changes", "[query]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Speed>("Speed");
+
+  Entity early = reg.spawn_entity();
+  Entity late = reg.spawn_entity();
+  Entity partial = reg.spawn_entity();
+  reg.add_component(early, Position(1.0f, 0.0f));
+  reg.add_component(early, Speed(1.0, 0.0));
+  reg.add_component(partial, Position(0.0f, 0.0f));
+
+  auto members = [&reg]()
+  {
+    std::vector<std::size_t> visited;
+    reg.query<Position, Speed const>().each(
+        [&visited](Entity e, Position& pos, Speed const& speed)
+        {
+          pos.pos.x += static_cast<float>(speed.speed.x);
+          visited.push_back(e);
+        });
+    std::ranges::sort(visited);
+    return visited;
+  };
+
+  REQUIRE(members() == std::vector<std::size_t> {early});
+  REQUIRE(reg.get_components<Position>()[early]->pos.x == 2.0f);
+
+  reg.add_component(late, Speed(2.0, 0.0));
+  reg.add_component(late, Position(0.0f, 0.0f));
+  REQUIRE(members() == std::vector<std::size_t> {early, late});
+  REQUIRE(reg.query<Speed, Position>().count() == 2);
+
+  reg.remove_component<Speed>(early);
+  REQUIRE(members() == std::vector<std::size_t> {late});
+
+  reg.kill_entity(late);
+  reg.process_entity_deletions();
+  REQUIRE(members().empty());
+
+  reg.add_component(partial, Speed(1.0, 0.0));
+  reg.register_component<Speed>("Speed");
+  REQUIRE(members().empty());
+}
+
+TEST_CASE("Group - owned storages keep members packed in front", "[group]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Direction>("Direction");
+  reg.register_component<Speed>("Speed");
+
+  for (std::size_t i = 0; i < 100; i++) {
+    auto e = reg.spawn_entity();
+    reg.add_component(e, Position(0.0f, 0.0f));
+    if (i % 2 == 0) {
+      reg.emplace_component<Speed>(e, 1.0, 0.0);
+    }
+    if (i % 3 == 0) {
+      reg.add_component(e, Direction(1.0f, 0.0f));
+    }
+  }
+
+  auto members = [&reg]()
+  {
+    std::vector<Entity> visited;
+    reg.group<Position, Direction const, Speed const>().each(
+        [&visited](Entity e, Position&, Direction const&, Speed const&)
+        { visited.push_back(e); });
+    std::ranges::sort(visited);
+    return visited;
+  };
+  auto packed = [&reg]()
+  {
+    std::size_t size =
+        reg.group<Position, Direction const, Speed const>().size();
+    auto const& pos = reg.get_components<Position>().entities();
+    auto const& dir = reg.get_components<Direction>().entities();
+    auto const& spd = reg.get_components<Speed>().entities();
+    return std::equal(pos.begin(), pos.begin() + size, dir.begin())
+        && std::equal(pos.begin(), pos.begin() + size, spd.begin());
+  };
+
+  REQUIRE(members().size() == 17);
+  REQUIRE(packed());
+
+  reg.remove_component<Speed>(0);
+  reg.kill_entity(6);
+  reg.process_entity_deletions();
+  reg.emplace_component<Speed>(3, 1.0, 0.0);
+  std::vector<Entity> expected;
+  for (Entity e = 0; e < 100; e++) {
+    if (e % 6 == 0 && e != 0 && e != 6) {
+      expected.push_back(e);
+    }
+  }
+  expected.insert(expected.begin(), 3);
+  REQUIRE(members() == expected);
+  REQUIRE(packed());
+
+  reg.group<Position, Direction const, Speed const>().par_each(
+      [](Entity, Position& pos, Direction const& dir, Speed const& spd)
+      { pos.pos += dir.direction * spd.speed.x; });
+  REQUIRE(reg.get_components<Position>()[12]->pos.x == 1.0);
+  REQUIRE(reg.get_components<Position>()[2]->pos.x == 0.0);
+  REQUIRE_THROWS_AS((reg.group<Position, Speed>()), std::logic_error);
+}
+
+TEST_CASE("Group - members do not move under a running Zipper", "[group]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Direction>("Direction");
+  reg.register_component<Speed>("Speed");
+
+  for (std::size_t i = 0; i < 20; i++) {
+    auto e = reg.spawn_entity();
+    reg.add_component(e, Position(0.0f, 0.0f));
+    reg.add_component(e, Direction(1.0f, 0.0f));
+    if (i % 2 == 0) {
+      reg.emplace_component<Speed>(e, 1.0, 0.0);
+    }
+  }
+  REQUIRE(reg.group<Position, Direction const, Speed const>().size() == 10);
+
+  // Joining or leaving the group would swap Position slots around the cursor
+  std::vector<std::size_t> visited;
+  for (auto&& [e, pos] : ZipperIndex<Position const>(reg)) {
+    visited.push_back(e);
+    if (e % 2 == 1) {
+      reg.emplace_component<Speed>(e, 1.0, 0.0);
+    } else if (e % 4 == 0) {
+      reg.remove_component<Speed>(e);
+    }
+  }
+  std::ranges::sort(visited);
+  REQUIRE(visited.size() == 20);
+  REQUIRE(std::ranges::adjacent_find(visited) == visited.end());
+
+  auto group = reg.group<Position, Direction const, Speed const>();
+  std::size_t size = group.size();
+  auto const& pos = reg.get_components<Position>().entities();
+  auto const& spd = reg.get_components<Speed>().entities();
+  REQUIRE(size == 15);
+  REQUIRE(std::equal(pos.begin(), pos.begin() + size, spd.begin()));
+}
+
+TEST_CASE("Zipper - tag components are stored as bitsets", "[zipper]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.register_component<Frozen>("Frozen");
+  reg.register_component<Boss>("Boss");
+
+  std::vector<Entity> entities;
+  for (int i = 0; i < 200; i++) {
+    entities.push_back(reg.spawn_entity());
+  }
+  for (Entity e : {3, 70, 130, 199}) {
+    reg.add_component(e, Frozen());
+  }
+  for (Entity e : {70, 130, 150}) {
+    reg.emplace_component<Boss>(e);
+  }
+  reg.add_component(Entity {130}, Position(1.0f, 1.0f));
+  reg.add_component(Entity {150}, Position(2.0f, 2.0f));
+
+  auto const& frozen = reg.get_components<Frozen>();
+  REQUIRE(frozen.count() == 4);
+  REQUIRE(frozen.entities() == std::vector<std::size_t> {3, 70, 130, 199});
+  REQUIRE(reg.has_component<Frozen, Boss>(70));
+  REQUIRE_FALSE(reg.has_component<Frozen>(150));
+
+  std::vector<std::size_t> both;
+  for (auto&& [e, f, b] : ZipperIndex<Frozen const, Boss const>(reg)) {
+    both.push_back(e);
+  }
+  REQUIRE(both == std::vector<std::size_t> {70, 130});
+
+  std::vector<std::size_t> frozen_bosses_with_pos;
+  for (auto&& [e, pos, b, f] : ZipperIndex<Position, Boss, Frozen const>(reg))
+  {
+    frozen_bosses_with_pos.push_back(e);
+  }
+  REQUIRE(frozen_bosses_with_pos == std::vector<std::size_t> {130});
+
+  reg.kill_entity(70);
+  reg.remove_component<Frozen>(130);
+  reg.process_entity_deletions();
+  REQUIRE(reg.get_components<Boss>().count() == 2);
+  REQUIRE(frozen.entities() == std::vector<std::size_t> {3, 199});
+}
+
+TEST_CASE("Zipper - filters entities by interned scene state", "[zipper]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  reg.register_component<Position>("Position");
+  reg.add_scene("menu", SceneState::MAIN);
+  reg.add_scene("game", SceneState::ACTIVE);
+  reg.add_scene("pause", SceneState::DISABLED);
+
+  Entity menu = reg.spawn_entity();
+  Entity game = reg.spawn_entity();
+  Entity pause = reg.spawn_entity();
+  Entity unknown = reg.spawn_entity();
+  Entity none = reg.spawn_entity();
+  reg.add_component(menu, Scene("menu"));
+  reg.add_component(game, Scene("game"));
+  reg.add_component(pause, Scene("pause"));
+  reg.add_component(unknown, Scene("nowhere"));
+  for (Entity e : {menu, game, pause, unknown, none}) {
+    reg.add_component(e, Position(0.0f, 0.0f));
+  }
+
+  auto visit = [&reg](SceneState level)
+  {
+    std::vector<std::size_t> visited;
+    for (auto&& [e, pos] : ZipperIndex<Position>(reg, level)) {
+      visited.push_back(e);
+    }
+    std::ranges::sort(visited);
+    return visited;
+  };
+
+  REQUIRE(reg.get_components<Scene>()[menu]->id
+          == reg.intern_scene("menu"));
+  REQUIRE(visit(SceneState::DISABLED)
+          == std::vector<std::size_t> {menu, game, pause, none});
+  REQUIRE(visit(SceneState::ACTIVE)
+          == std::vector<std::size_t> {menu, game, none});
+  REQUIRE(visit(SceneState::MAIN) == std::vector<std::size_t> {menu, none});
+
+  reg.deactivate_scene("game");
+  reg.activate_scene("pause");
+  REQUIRE(visit(SceneState::ACTIVE)
+          == std::vector<std::size_t> {menu, pause, none});
+}
+
+TEST_CASE("Offset - survives absolute Position writes", "[transform]")
+{
+  Registry reg;
+  reg.register_component<Position>("moving:Position");
+  auto& offsets = reg.register_component<Offset>("moving:Offset");
+
+  Entity e = reg.spawn_entity();
+  reg.add_component(e, Position(0.0, 0.0));
+  reg.add_component(e, Offset(0.5, -0.25));
+
+  auto& pos = *reg.get_components<Position>()[e];
+  pos.pos = Vector2D(2.0, 1.0);
+  REQUIRE(world_position(offsets, e, pos) == Vector2D(2.5, 0.75));
+  pos.pos = Vector2D(-1.0, 0.0);
+  REQUIRE(world_position(offsets, e, pos) == Vector2D(-0.5, -0.25));
+}
+
+TEST_CASE("TransformHierarchy - places parents before their children",
+          "[transform]")
+{
+  Registry reg;
+  reg.init_scene_management();
+  auto& positions = reg.register_component<Position>("moving:Position");
+  reg.register_component<Offset>("moving:Offset");
+  reg.register_component<Parent>("moving:Parent");
+
+  // Lower ids deeper in the chain, an id ordered walk would lag a frame
+  Entity grandchild = reg.spawn_entity();
+  Entity child = reg.spawn_entity();
+  Entity root = reg.spawn_entity();
+  reg.add_component(root, Position(1.0, 1.0));
+  reg.add_component(root, Offset(0.5, 0.0));
+  reg.add_component(child, Position(0.0, 0.0));
+  reg.add_component(child, Offset(0.0, 0.25));
+  reg.add_component(child, Parent(root));
+  reg.add_component(grandchild, Position(0.0, 0.0));
+  reg.add_component(grandchild, Parent(child));
+
+  TransformHierarchy hierarchy;
+  std::vector<Entity> moved;
+  hierarchy.update(reg, moved);
+  REQUIRE(hierarchy.order().front().second == child);
+  REQUIRE(positions[child]->pos == Vector2D(1.5, 1.0));
+  REQUIRE(positions[grandchild]->pos == Vector2D(1.5, 1.25));
+  REQUIRE(moved == std::vector<Entity> {child, grandchild});
+
+  moved.clear();
+  hierarchy.update(reg, moved);
+  REQUIRE(moved.empty());
+
+  positions.modify(root)->pos = Vector2D(0.0, 0.0);
+  hierarchy.update(reg, moved);
+  REQUIRE(positions[grandchild]->pos == Vector2D(0.5, 0.25));
+  REQUIRE(moved.size() == 2);
+
+  reg.remove_component<Parent>(grandchild);
+  hierarchy.update(reg, moved);
+  REQUIRE(hierarchy.order().size() == 1);
+}
+
+TEST_CASE("TransformHierarchy - only revisits children whose ancestors moved",
+          "[transform]")
+{
+  Registry reg;
+  EventManager em;
+  reg.init_scene_management();
+  auto& positions = reg.register_component<Position>("moving:Position");
+  reg.register_component<Offset>("moving:Offset");
+  reg.register_component<Parent>("moving:Parent");
+
+  Entity root = reg.spawn_entity();
+  Entity child = reg.spawn_entity();
+  Entity grandchild = reg.spawn_entity();
+  reg.add_component(root, Position(1.0, 1.0));
+  reg.add_component(root, Offset(0.5, 0.0));
+  reg.add_component(child, Position(0.0, 0.0));
+  reg.add_component(child, Parent(root));
+  reg.add_component(grandchild, Position(0.0, 0.0));
+  reg.add_component(grandchild, Parent(child));
+
+  TransformHierarchy hierarchy;
+  std::vector<Entity> moved;
+  reg.add_system([&hierarchy, &moved](Registry& r)
+                 { hierarchy.update(r, moved); });
+  reg.run_systems(em);
+  reg.run_systems(em);
+  REQUIRE(positions[grandchild]->pos == Vector2D(1.5, 1.0));
+
+  // An untracked write is not seen, the cached positions are trusted
+  moved.clear();
+  positions[grandchild]->pos = Vector2D(9.0, 9.0);
+  reg.run_systems(em);
+  REQUIRE(moved.empty());
+
+  positions.modify(root)->pos = Vector2D(2.0, 0.0);
+  reg.run_systems(em);
+  REQUIRE(moved == std::vector<Entity> {child, grandchild});
+  REQUIRE(positions[grandchild]->pos == Vector2D(2.5, 0.0));
+
+  // Removing an Offset stamps nothing, the children still follow
+  moved.clear();
+  reg.remove_component<Offset>(root);
+  reg.run_systems(em);
+  REQUIRE(moved == std::vector<Entity> {child, grandchild});
+  REQUIRE(positions[grandchild]->pos == Vector2D(2.0, 0.0));
+}
+
 TEST_CASE("Dummy test", "[dummy]")
 {
   REQUIRE(true);